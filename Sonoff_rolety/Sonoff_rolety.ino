@@ -2,7 +2,7 @@
  Sonoff 4ch (ESP8285) MQTT sensor for shutters
  Generic 8285 module
  (or 8266 module,  FlashMode DOUT!!!!!)
- 1M (no SPIFFS)
+ 1M (64K SPIFFS) - the file system area holds the position journal (1M (no SPIFFS) works too, saving to EEPROM)
  Reset method: ck
  
  RX <-> RX !!!
@@ -34,6 +34,12 @@ cover:
     state_closed: 100
     tilt_command_topic: 'blinds/cover1/tilt'
     tilt_status_topic: 'blinds/cover1/tilt-state'
+With _json_state_ the state of both covers is sent in one message to the state topic (_publish_state_ by default, configure page), e.g.
+ {"position":[100,0],"movement":["stopped","down"],"tilt":[50,0]}
+    state_topic: "blinds/cover/json-state"
+    value_template: "{{ value_json.position[0] }}"
+    tilt_status_topic: "blinds/cover/json-state"
+    tilt_status_template: "{{ value_json.tilt[0] }}"
  
 */
 
@@ -46,11 +52,12 @@ cover:
 #include <PubSubClient.h> // MQTT
 #include <ArduinoOTA.h>   // (Over The Air) update
 
-#include <ArduinoJson.h>
 #include <math.h>
 #include "shutter_class.h"
 #include "config.h"
 #include "crc.h"
+#include "journal.h"
+#include "json_writer.h"
 #include "web.h"
 
 unsigned long lastUpdate = 0; // timestamp - last MQTT update
@@ -58,23 +65,33 @@ unsigned long lastCallback = 0; // timestamp - last MQTT callback received
 unsigned long lastWiFiDisconnect=0;
 unsigned long lastWiFiConnect=0;
 unsigned long lastMQTTDisconnect=0; // last time MQTT was disconnected
+unsigned long mqttConnectBlocking=0; // last connect - TCP (and TLS handshake), the loop is stopped for this long
+unsigned long mqttConnectTime=0;     // last connect - until CONNACK
 unsigned long WiFiLEDOn=0;
 unsigned long k1_up_pushed=0;
 unsigned long k1_down_pushed=0;
 unsigned long k2_up_pushed=0;
 unsigned long k2_down_pushed=0;
 
-String lastCommand = "";
+char lastCommand[120] = "";   // last MQTT message, shown on the web page
 String crcStatus="";
 
-configuration cfg,web_cfg;
+configuration cfg;
+boolean web_defaults=false;  // "Load defaults" on the configure page - it shows and saves the default values
+configuration web_cfg;       // scratch copy of the configure page (saveConfig checks into it) - static, no heap per request
 Shutter r1;
 Shutter r2;
 
-// MQTT callback declaratiion (definition below)
-void callback(char* topic, byte* payload, unsigned int length); 
+// MQTT handlers registration (definition below)
+void mqttHandlers();
 
-WiFiClient espClient;         // WiFi
+#ifdef _mqtt_tls_
+  BearSSL::WiFiClientSecure espClient;  // TLS over WiFi
+  BearSSL::Session tlsSession;          // kept for the next connect - resumed instead of a full handshake
+  boolean tlsProbed=false;              // MFLN support of the broker asked (once, needs the network)
+#else
+  WiFiClient espClient;         // WiFi
+#endif
 //ESP8266WiFiMulti wifiMulti;   // Primary and secondary WiFi
 
 // Tady musim inicializovat mqtt_server po setup
@@ -88,49 +105,100 @@ PubSubClient mqqtClient(espClient);   // MQTT client
 
 /************************ 
 * S E T U P   W I F I  
+* Connects in the background (checkWiFi() from the loop) - buttons and timers keep running while the network is down
 *************************/
-void setup_wifi() {
-  delay(10);
-  // We start by connecting to a WiFi network
-  #ifdef DEBUG
-    Serial.println();
-    Serial.print("Connecting to WiFi");
-  #endif
+enum wifi_state { WIFI_START, WIFI_CONNECTING, WIFI_CONNECTED, WIFI_WAIT };
+
+wifi_state wifiState=WIFI_START;
+unsigned long wifiStateTime=0;    // when the current state started
+unsigned long wifiBackoff=wifi_backoff_min;
+byte wifiNetwork=0;               // 0 - ssid1, 1 - ssid2 (wifi_multi)
+byte wifiFailures=0;              // failed attempts since the last connection
+boolean wifiEverConnected=false;  // since boot
 
+void setup_wifi() {
   WiFi.hostname(cfg.host_name);
   WiFi.mode(WIFI_STA); // Pouze WiFi client!!
-  WiFi.begin(cfg.wifi_ssid1, cfg.wifi_password1);
-//  wifiMulti.addAP(cfg.wifi_ssid1, cfg.wifi_password1);
-//  wifiMulti.addAP(cfg.wifi_ssid2, cfg.wifi_password2);
-  int i=0;
-//  while (wifiMulti.run() != WL_CONNECTED && i<20) {
-  while (WiFi.status() != WL_CONNECTED && i<60) {
-    i++;
-    delay(500);
-    #ifdef DEBUG
-      Serial.print(".");
-    #endif
+  WiFi.setAutoReconnect(true);
+  wifiState=WIFI_START;
+}
+
+void wifiConnected(unsigned long now) {
+  wifiState=WIFI_CONNECTED;
+  wifiBackoff=wifi_backoff_min;
+  wifiFailures=0;
+  lastWiFiConnect=now;
+  if (!wifiEverConnected) {
+    wifiEverConnected=true;
+    MDNS.begin(cfg.host_name);
+    ArduinoOTA.begin();
   }
-  if (WiFi.status() != WL_CONNECTED && (strcmp(cfg.wifi_ssid1,_ssid1_)!=0 || strcmp(cfg.wifi_password1,_password1_)!=0))  {
+  #ifdef DEBUG
+    Serial.printf("Connected to %s\n", WiFi.SSID().c_str());
+    Serial.print("IP address: ");
+    Serial.println(WiFi.localIP());
+  #endif
+}
+
+void wifiFailed(unsigned long now) {
+  WiFi.disconnect();
+  wifiFailures++;
+  if (cfg.wifi_multi && cfg.wifi_ssid2[0]!=0) wifiNetwork^=1;   // try the other one
+  // Never connected since boot with a changed configuration - probably wrong, go back to the defaults
+  if (!wifiEverConnected && wifiFailures>=wifi_default_attempts && (strcmp(cfg.wifi_ssid1,_ssid1_)!=0 || strcmp(cfg.wifi_password1,_password1_)!=0))  {
     #ifdef DEBUG
-       Serial.println();
-       Serial.print("Loading defaults and restarting...");
+       Serial.println("Loading defaults and restarting...");
     #endif
     defaultConfig(&cfg);
     saveConfig();
     Restart();
-    delay(10000);
   }
-  MDNS.begin(cfg.host_name);
-
+  wifiState=WIFI_WAIT;
+  wifiStateTime=now;
   #ifdef DEBUG
-    Serial.println("");
-    Serial.printf("Connected to %s\n", WiFi.SSID().c_str());
-    Serial.print("IP address: ");
-    Serial.println(WiFi.localIP());
+    Serial.printf("WiFi failed, next attempt in %lu ms\n",wifiBackoff);
   #endif
 }
 
+// Returns true when connected
+boolean checkWiFi() {
+  unsigned long now=millis();
+  switch (wifiState) {
+    case WIFI_START:
+      #ifdef DEBUG
+        Serial.printf("Connecting to WiFi %d\n",wifiNetwork+1);
+      #endif
+      if (wifiNetwork==0) {
+        WiFi.begin(cfg.wifi_ssid1, cfg.wifi_password1);
+      } else {
+        WiFi.begin(cfg.wifi_ssid2, cfg.wifi_password2);
+      }
+      wifiState=WIFI_CONNECTING;
+      wifiStateTime=now;
+      break;
+    case WIFI_CONNECTING:   // association and DHCP
+      if (WiFi.status()==WL_CONNECTED) {
+        wifiConnected(now);
+      } else if (now-wifiStateTime>wifi_connect_timeout) {
+        wifiFailed(now);
+      }
+      break;
+    case WIFI_CONNECTED:
+      if (WiFi.status()!=WL_CONNECTED) {
+        wifiState=WIFI_CONNECTING;   // the SDK reconnects by itself, if it doesn't manage we try the other network
+        wifiStateTime=now;
+      }
+      break;
+    case WIFI_WAIT:
+      if (now-wifiStateTime>=wifiBackoff) {
+        wifiBackoff=min(wifiBackoff*2,(unsigned long)wifi_backoff_max);
+        wifiState=WIFI_START;
+      }
+      break;
+  }
+  return wifiState==WIFI_CONNECTED;
+}
+
 
 /********************************************
 * M A I N   A R D U I N O   S E T U P 
@@ -152,7 +220,6 @@ void setup() {
 // Open EEPROM
   openMemory();
   loadConfig();
-  copyConfig(&cfg,&web_cfg);
   loadStatus();
 
   pinMode(cfg.GPIO_KEY1, INPUT_PULLUP);
@@ -169,8 +236,26 @@ void setup() {
 
   setup_wifi();
   
-  mqqtClient.setServer(cfg.mqtt_server,1883);
-  mqqtClient.setCallback(callback);
+  espClient.setTimeout(mqtt_tcp_timeout);  // the TCP connect still blocks, keep it short
+  #ifdef _mqtt_tls_
+    espClient.setSession(&tlsSession);
+    if (cfg.mqtt_fingerprint[0]!=0) {
+      espClient.setFingerprint(cfg.mqtt_fingerprint);
+    } else {
+      espClient.setInsecure();
+    }
+  #endif
+  mqqtClient.setServer(cfg.mqtt_server,cfg.mqtt_port);
+  mqqtClient.setKeepAlive(mqtt_keepalive);
+  mqqtClient.setSocketTimeout(mqtt_socket_timeout);
+  mqttHandlers();
+  mqqtClient.setOfflineQueue(true);
+  mqqtClient.setDisconnectOnRefused(true);   // without its command topics the device is useless - reconnect and subscribe again
+  mqqtClient.setBufferSize(mqtt_rx_buffer,mqtt_tx_buffer);
+  #ifdef _mqtt5_
+    mqqtClient.setProtocolVersion(MQTT_VERSION_5);
+    mqqtClient.setSessionExpiry(mqtt_session_expiry);
+  #endif
   
 // Over The Air Update
   ArduinoOTA.setHostname(cfg.host_name);
@@ -200,16 +285,19 @@ void setup() {
       else if (error == OTA_END_ERROR) Serial.println("End Failed");
     #endif
   });
-  ArduinoOTA.begin();  
+  // ArduinoOTA.begin() when WiFi connects
 
 #ifdef _WEB_
 // Zapnout Web Server
   server.on("/", handleRootPath);    //Associate the handler function to the path
   server.on("/configure",handleConfigurePath);
   server.on("/readMain", readMain);
+  server.on("/events", handleEvents);
   server.on("/readConfig",readConfig);
   server.on("/pressButton",pressButton);
-  server.on("/updateField",updateField);
+  server.on("/saveConfig",HTTP_POST,handleSaveConfig);
+  const char* headers[] = {"If-None-Match"};
+  server.collectHeaders(headers,1);    // for the page ETags
   httpUpdater.setup(&server,"/upgrade","admin","J1kubJeN1sKluk");
   server.begin();                    //Start the server
 #endif
@@ -240,57 +328,117 @@ String macToStr(const uint8_t* mac)
 /********************************
 * R E C O N N E C T   M Q T T 
 ********************************/
-void reconnect() {
+unsigned long mqttBackoff=mqtt_backoff_min;  // doubles with every failed attempt
+boolean mqttResubscribe=false;  // the broker refused a subscription - subscribe again after the reconnect
+
+// CONNACK received - resubscribe
+void mqttConnected() {
   #ifdef DEBUG
-    Serial.print("Attempting MQTT connection...");
+    Serial.println("connected");
+  #endif
+
+  // Once connected, publish an announcement...
+  digitalWrite(SLED, LOW);   // Turn the Status Led on
+  if (!mqttResubscribe) mqttBackoff=mqtt_backoff_min;   // otherwise only once the subscriptions are accepted
+  mqttConnectTime=millis()-lastMQTTDisconnect;
+  // lastUpdate=0;
+  // checkSensors(); // send current sensors
+  // publishSensor();
+
+  #ifdef _mqtt5_
+    // the broker kept the session, subscriptions included (but not the refused ones)
+    if (mqqtClient.sessionPresent() && !mqttResubscribe) return;
+  #endif
+
+  // resubscribe - all topics in one SUBSCRIBE (more only if they don't fit into the buffer)
+  const char* topics[8];
+  size_t n=0;
+  topics[n++]=cfg.subscribe_command1;  // listen to control for cover 1
+  topics[n++]=cfg.subscribe_position1;  // listen to cover 1 postion set
+  topics[n++]=cfg.subscribe_reboot;  // listen for reboot command
+  topics[n++]=cfg.subscribe_calibrate;  // listen for calibration command
+  if (cfg.two_covers) {
+    topics[n++]=cfg.subscribe_command2;  // listen to control for cover 2
+    topics[n++]=cfg.subscribe_position2;  // listen to cover 2 position set
+  }
+  if (cfg.tilt) {
+    topics[n++]=cfg.subscribe_tilt1;  // listen for cover 1 tilt position set
+    if (cfg.two_covers) {
+      topics[n++]=cfg.subscribe_tilt2;  // listen for cover 2 tilt position set
+    }
+  }
+  if (!mqqtClient.subscribe(topics,NULL,n)) {
+    #ifdef DEBUG
+      Serial.println("subscribe failed");
+    #endif
+    mqqtClient.disconnect();  // try again with the next reconnect
+  }
+}
+
+void mqttFailed() {
+  digitalWrite(SLED, HIGH);   // Turn the Status Led off
+  mqttBackoff=min(mqttBackoff*2,(unsigned long)mqtt_backoff_max);
+  #ifdef DEBUG
+    Serial.print("failed, rc=");
+    Serial.print(mqqtClient.state());
   #endif
+}
 
+// Called from the loop while MQTT is not connected - never waits for the broker
+void reconnect() {
   unsigned long now = millis();
-  if (lastMQTTDisconnect!=0 && lastMQTTDisconnect<now && abs(now-lastMQTTDisconnect)<10000) return;
+  if (mqqtClient.state()==MQTT_SUBSCRIBE_REFUSED && !mqttResubscribe) {
+    // SUBACK refused a filter and the client disconnected - back off as after a failed connect
+    mqttResubscribe=true;
+    lastMQTTDisconnect=now;
+    mqttFailed();
+  }
+  if (mqqtClient.state()==MQTT_CONNECTING) {
+    switch (mqqtClient.connectPoll()) {
+      case MQTT_POLL_CONNECTED:
+        mqttConnected();
+        break;
+      case MQTT_POLL_FAILED:
+        mqttFailed();
+        break;
+    }
+    return;
+  }
+  if (lastMQTTDisconnect!=0 && now-lastMQTTDisconnect<mqttBackoff) return;
   lastMQTTDisconnect=now;
+  #ifdef DEBUG
+    Serial.print("Attempting MQTT connection...");
+  #endif
   // Attempt to connect
+
+  #ifdef _mqtt_tls_
+    if (!tlsProbed) {
+      // Smaller TLS buffers when the broker supports MFLN, otherwise a full record has to fit in
+      tlsProbed=true;
+      if (espClient.probeMaxFragmentLength(cfg.mqtt_server,cfg.mqtt_port,tls_fragment)) {
+        espClient.setBufferSizes(tls_fragment,tls_fragment);
+      } else {
+        espClient.setBufferSizes(16384,tls_fragment);
+      }
+    }
+  #endif
   
   uint8_t mac[6];
   WiFi.macAddress(mac);
   String clientName(cfg.host_name);
   clientName += "-";
   clientName += macToStr(mac);
-  clientName += "-";
-  clientName += String(micros() & 0xff, 16);
-  
-  if (mqqtClient.connect((char*)clientName.c_str(),cfg.mqtt_user,cfg.mqtt_password)) {
-    #ifdef DEBUG
-      Serial.println("connected");
-    #endif
-
-    // Once connected, publish an announcement...
-    digitalWrite(SLED, LOW);   // Turn the Status Led on
-    // lastUpdate=0;
-    // checkSensors(); // send current sensors
-    // publishSensor();
-
-    // resubscribe
-    mqqtClient.subscribe(cfg.subscribe_command1);  // listen to control for cover 1
-    mqqtClient.subscribe(cfg.subscribe_position1);  // listen to cover 1 postion set
-    mqqtClient.subscribe(cfg.subscribe_reboot);  // listen for reboot command
-    mqqtClient.subscribe(cfg.subscribe_calibrate);  // listen for calibration command
-    if (cfg.two_covers) {
-      mqqtClient.subscribe(cfg.subscribe_command2);  // listen to control for cover 2
-      mqqtClient.subscribe(cfg.subscribe_position2);  // listen to cover 2 position set
-    }
-    if (cfg.tilt) {
-      mqqtClient.subscribe(cfg.subscribe_tilt1);  // listen for cover 1 tilt position set
-      if (cfg.two_covers) {
-        mqqtClient.subscribe(cfg.subscribe_tilt2);  // listen for cover 2 tilt position set
-      }
-    }
-  } else {
-    digitalWrite(SLED, HIGH);   // Turn the Status Led off
-    #ifdef DEBUG
-      Serial.print("failed, rc=");
-      Serial.print(mqqtClient.state());
-    #endif
+  #ifdef _mqtt5_
+    // the session is found by the client name - it has to stay the same, no clean session
+    if (!mqqtClient.beginConnect((char*)clientName.c_str(),cfg.mqtt_user,cfg.mqtt_password,NULL,0,false,NULL,false)) {
+  #else
+    clientName += "-";
+    clientName += String(micros() & 0xff, 16);
+    if (!mqqtClient.beginConnect((char*)clientName.c_str(),cfg.mqtt_user,cfg.mqtt_password)) {
+  #endif
+    mqttFailed();
   }
+  mqttConnectBlocking=millis()-now;
 }
 
 void Restart() {
@@ -313,87 +461,176 @@ void Restart() {
     ESP.restart();  
 }
 
-// Callback for processing MQTT message
-void callback(char* topic, byte* payload, unsigned int length) {
-
-  char* payload_copy = (char*)malloc(length+1);
-  memcpy(payload_copy,payload,length);
-  payload_copy[length] = '\0';
+// Payload of a received command as a C string (only the start of it, commands are short), noted for the web page
+// Topic and payload point into the MQTT client buffer (no copy, no heap)
+void commandReceived(const char* topic, size_t topicLen, const uint8_t* payload, size_t length, char* text, size_t size) {
+  size_t n = length<size ? length : size-1;
+  memcpy(text,payload,n);
+  text[n] = '\0';
 
   #ifdef DEBUG
     Serial.print("Message arrived [");
-    Serial.print(topic);
+    Serial.write((const uint8_t*)topic,topicLen);
     Serial.print("] ");
-    Serial.println(payload_copy);
+    Serial.println(text);
   #endif
-  lastCommand="Topic:";
-  lastCommand+=topic;
-  lastCommand+=",  Payload:";
-  lastCommand+=payload_copy;
+  snprintf(lastCommand,sizeof(lastCommand),"Topic:%.*s,  Payload:%s",(int)topicLen,topic,text);
   
   lastCallback= millis();
+}
+
+void coverCommand(Shutter& r, const char* text) {
+  if (strcmp(text,payload_open) == 0) {
+    r.Start_up();
+  } else if (strcmp(text,payload_close) == 0) {
+    r.Start_down();
+  } else if (strcmp(text,payload_stop) == 0) {
+    r.Stop(); 
+  }
+}
+
+void coverPosition(Shutter& r, const char* text) {
+  #ifdef _reverse_position_mapping_
+    int p = map(constrain(atoi(text),0,100),0,100,100,0);
+  #else
+    int p = constrain(atoi(text),0,100);
+  #endif
+  if (p!=r.getPosition()) {
+    r.Go_to_position(p);   
+  } else {
+    r.force_update=true;
+  }    
+}
+
+void coverTilt(Shutter& r, const char* text) {
+  int tilt = constrain(atoi(text),0,100);
+  if (tilt!=r.getTilt()) {      
+    r.tilt_it(tilt);
+  } else {
+    r.force_update=true;
+  }
+}
+
+// MQTT handlers, one per subscribed topic (dispatched by the client, see mqttHandlers)
+void onCommand1(const char* topic, size_t topicLen, const uint8_t* payload, size_t length, uint16_t msgId, uint8_t qos, boolean retain) {
+  char text[16];
+  commandReceived(topic,topicLen,payload,length,text,sizeof(text));
+  coverCommand(r1,text);
+}
+
+void onCommand2(const char* topic, size_t topicLen, const uint8_t* payload, size_t length, uint16_t msgId, uint8_t qos, boolean retain) {
+  char text[16];
+  commandReceived(topic,topicLen,payload,length,text,sizeof(text));
+  coverCommand(r2,text);
+}
+
+void onPosition1(const char* topic, size_t topicLen, const uint8_t* payload, size_t length, uint16_t msgId, uint8_t qos, boolean retain) {
+  char text[16];
+  commandReceived(topic,topicLen,payload,length,text,sizeof(text));
+  coverPosition(r1,text);
+}
+
+void onPosition2(const char* topic, size_t topicLen, const uint8_t* payload, size_t length, uint16_t msgId, uint8_t qos, boolean retain) {
+  char text[16];
+  commandReceived(topic,topicLen,payload,length,text,sizeof(text));
+  coverPosition(r2,text);
+}
+
+void onTilt1(const char* topic, size_t topicLen, const uint8_t* payload, size_t length, uint16_t msgId, uint8_t qos, boolean retain) {
+  char text[16];
+  commandReceived(topic,topicLen,payload,length,text,sizeof(text));
+  coverTilt(r1,text);
+}
 
-  if (strcmp(topic, cfg.subscribe_command1) == 0) {
+void onTilt2(const char* topic, size_t topicLen, const uint8_t* payload, size_t length, uint16_t msgId, uint8_t qos, boolean retain) {
+  char text[16];
+  commandReceived(topic,topicLen,payload,length,text,sizeof(text));
+  coverTilt(r2,text);
+}
 
-    if (strcmp(payload_copy,payload_open) == 0) {
-      r1.Start_up();
-    } else if (strcmp(payload_copy,payload_close) == 0) {
-      r1.Start_down();
-    } else if (strcmp(payload_copy,payload_stop) == 0) {
-      r1.Stop(); 
+void onCalibrate(const char* topic, size_t topicLen, const uint8_t* payload, size_t length, uint16_t msgId, uint8_t qos, boolean retain) {
+  char text[16];
+  commandReceived(topic,topicLen,payload,length,text,sizeof(text));
+  r1.Calibrate();
+  r2.Calibrate();
+}
+
+void onReboot(const char* topic, size_t topicLen, const uint8_t* payload, size_t length, uint16_t msgId, uint8_t qos, boolean retain) {
+  char text[16];
+  commandReceived(topic,topicLen,payload,length,text,sizeof(text));
+  Restart();
+}
+
+// Topics from the configuration (may contain + and # wildcards) - a configuration change restarts the device
+void mqttHandlers() {
+  mqqtClient.addFilter(cfg.subscribe_command1,onCommand1);
+  mqqtClient.addFilter(cfg.subscribe_position1,onPosition1);
+  mqqtClient.addFilter(cfg.subscribe_reboot,onReboot);
+  mqqtClient.addFilter(cfg.subscribe_calibrate,onCalibrate);
+  if (cfg.two_covers) {
+    mqqtClient.addFilter(cfg.subscribe_command2,onCommand2);
+    mqqtClient.addFilter(cfg.subscribe_position2,onPosition2);
+  }
+  if (cfg.tilt) {
+    mqqtClient.addFilter(cfg.subscribe_tilt1,onTilt1);
+    if (cfg.two_covers) {
+      mqqtClient.addFilter(cfg.subscribe_tilt2,onTilt2);
     }
-  } else if (cfg.two_covers && strcmp(topic, cfg.subscribe_command2) == 0) {
-    if (strcmp(payload_copy,payload_open) == 0) {
-      r2.Start_up();
-    } else if (strcmp(payload_copy,payload_close) == 0) {
-      r2.Start_down();
-    } else if (strcmp(payload_copy,payload_stop) == 0) {
-      r2.Stop();
+  }
+}
+
+/*****************************************************************
+* S E N D   S T A T E   M Q Q T  ( O N E   J S O N   M E S S A G E )
+******************************************************************/
+// Adds a RAM string as the next part of the payload
+void addSegment(MQTTSegment* parts,uint8_t& n,const char* text) {
+  parts[n].data=(const uint8_t*)text;
+  parts[n].length=strlen(text);
+  n++;
+}
+
+// True if the message was sent or queued
+boolean publishState() {
+  char position1[5],position2[5],tilt1[5],tilt2[5];
+  MQTTSegment parts[16];
+  uint8_t n=0;
+
+  #ifdef _reverse_position_mapping_
+    itoa(map(r1.getPosition(),0,100,100,0),position1,10);
+    itoa(map(r2.getPosition(),0,100,100,0),position2,10);
+  #else
+    itoa(r1.getPosition(),position1,10);
+    itoa(r2.getPosition(),position2,10);
+  #endif
+  itoa(r1.getTilt(),tilt1,10);
+  itoa(r2.getTilt(),tilt2,10);
+  
+  // One PUBLISH for all covers, sent in parts straight from the constants and the numbers above - no message buffer
+  addSegment(parts,n,"{\"position\":[");
+  addSegment(parts,n,position1);
+  if (cfg.two_covers) {
+    addSegment(parts,n,",");
+    addSegment(parts,n,position2);
+  }
+  addSegment(parts,n,"],\"movement\":[\"");
+  addSegment(parts,n,r1.Movement());
+  if (cfg.two_covers) {
+    addSegment(parts,n,"\",\"");
+    addSegment(parts,n,r2.Movement());
+  }
+  addSegment(parts,n,"\"]");
+  if (cfg.tilt) {
+    addSegment(parts,n,",\"tilt\":[");
+    addSegment(parts,n,tilt1);
+    if (cfg.two_covers) {
+      addSegment(parts,n,",");
+      addSegment(parts,n,tilt2);
     }
-  } else if (strcmp(topic, cfg.subscribe_position1) == 0) {
-      #ifdef _reverse_position_mapping_
-        int p = map(constrain(atoi(payload_copy),0,100),0,100,100,0);
-      #else
-        int p = constrain(atoi(payload_copy),0,100);
-      #endif
-      if (p!=r1.getPosition()) {
-        r1.Go_to_position(p);   
-      } else {
-        r1.force_update=true;
-      }    
-  } else if (cfg.two_covers && strcmp(topic, cfg.subscribe_position2) == 0) {
-    
-      #ifdef _reverse_position_mapping_
-        int position = map(constrain(atoi(payload_copy),0,100),0,100,100,0);
-      #else
-        int position = constrain(atoi(payload_copy),0,100);
-      #endif
-      if (position!=r2.getPosition()) {
-        r2.Go_to_position(position);
-      } else {
-        r2.force_update=true;
-      }      
-  } else if (cfg.tilt && strcmp(topic, cfg.subscribe_tilt1) == 0) {
-      int tilt = constrain(atoi(payload_copy),0,100);
-      if (tilt!=r1.getTilt()) {      
-        r1.tilt_it(tilt);
-      } else {
-        r1.force_update=true;
-      }
-  } else if (cfg.tilt && cfg.two_covers && strcmp(topic, cfg.subscribe_tilt2) == 0) {
-      int tilt = constrain(atoi(payload_copy),0,100);
-      if (tilt!=r2.getTilt()) {      
-        r2.tilt_it(tilt);
-      } else {
-        r2.force_update=true;
-      }
-  } else if (strcmp(topic, cfg.subscribe_calibrate) == 0) {
-    r1.Calibrate();
-    r2.Calibrate();
-  } else if (strcmp(topic, cfg.subscribe_reboot) == 0) {    
-     Restart();
+    addSegment(parts,n,"]");
   }
-  free(payload_copy);
+  addSegment(parts,n,"}");
+
+  return mqqtClient.publishv(cfg.publish_state,parts,n,false,publish_qos);
 }
 
 /*****************************************************************
@@ -406,16 +643,28 @@ void publishSensor() {
   char message4[10];
   unsigned long now = millis();
 
-  unsigned long interval = ((r1.movement==stopped) && (r2.movement==stopped))?update_interval_passive:update_interval_active;
+  // Start or stop of a movement is sent immediately, position changes (beyond the deadband) at most every update_interval_active
+  // and the unchanged state only as a heartbeat every update_interval_heartbeat
+  boolean movement_changed = (r1.movement!=r1.published_movement) || (cfg.two_covers && r2.movement!=r2.published_movement);
+  boolean changed = r1.Changed_since_publish() || (cfg.two_covers && r2.Changed_since_publish());
+  boolean heartbeat = (lastUpdate==0 || lastUpdate>now || abs(now-lastUpdate)>update_interval_heartbeat);
+  boolean active = (lastUpdate>now || abs(now-lastUpdate)>update_interval_active);
   
-  if ( lastUpdate==0 || lastUpdate>now || abs(now-lastUpdate)>interval || r1.force_update || r2.force_update ) {  
+  if ( heartbeat || movement_changed || (changed && active) || r1.force_update || r2.force_update ) {  
+    // A cover counts as published only when all of its messages were sent or queued (QoS 1 window full,
+    // packet too long) - otherwise its change is sent again with the next update
+    boolean published1, published2;
+  #ifdef _json_state_
+    published1=published2=publishState();
+  #else
     // INFO: the data must be converted into a string; a problem occurs when using floats...
     #ifdef _reverse_position_mapping_    
       snprintf(message1,10,"%d",map(r1.getPosition(),0,100,100,0));
     #else
       snprintf(message1,10,"%d",r1.getPosition());
     #endif
-    mqqtClient.publish(cfg.publish_position1, message1 , false);
+    published1=mqqtClient.publish(cfg.publish_position1,(const uint8_t*)message1,strlen(message1),false,publish_qos);
+    published2=true;
     //yield();
 
     if (cfg.two_covers) {
@@ -424,24 +673,27 @@ void publishSensor() {
       #else
         snprintf(message2,10,"%d",r2.getPosition());
       #endif
-      mqqtClient.publish(cfg.publish_position2, message2 , false);
+      published2=mqqtClient.publish(cfg.publish_position2,(const uint8_t*)message2,strlen(message2),false,publish_qos);
     }
     //yield();
     if (cfg.tilt) {
       snprintf(message3,10, "%d", r1.getTilt());
-      mqqtClient.publish(cfg.publish_tilt1, message3 , false);
+      published1&=mqqtClient.publish(cfg.publish_tilt1,(const uint8_t*)message3,strlen(message3),false,publish_qos);
       //yield();
       if (cfg.two_covers) {
         snprintf(message4,10, "%d", r2.getTilt());
-        mqqtClient.publish(cfg.publish_tilt2, message4 , false);
+        published2&=mqqtClient.publish(cfg.publish_tilt2,(const uint8_t*)message4,strlen(message4),false,publish_qos);
         //yield();
       }
     }
+  #endif
     saveStatus();   
   #ifdef DEBUG_updates
     Serial.printf("position: %d/%d\n",r1.getPosition(),r2.getPosition());
   #endif
     
+    if (published1) r1.Mark_published();
+    if (published2) r2.Mark_published();
     r1.force_update=false;
     r2.force_update=false;
     lastUpdate=now;
@@ -563,16 +815,19 @@ void loop() {
   unsigned long now = millis();
   checkTimers();
   checkSensors();
-  if (WiFi.status() == WL_CONNECTED) {
-    lastWiFiConnect=now;  // Not used at the moment
+  if (checkWiFi()) {
+    MDNS.update();
     ArduinoOTA.handle(); // OTA first
-    if (mqqtClient.loop()) {
-       publishSensor();
-    } else {
+    if (!mqqtClient.loop()) {
       reconnect();      
+    } else if (mqttResubscribe && mqqtClient.subscribePending()==0) {
+      // every filter accepted this time
+      mqttResubscribe=false;
+      mqttBackoff=mqtt_backoff_min;
     }
     #ifdef _WEB_    
       server.handleClient();         // Web handling
+      pushEvents();                  // Live status to the open pages
     #endif
   } else {
     lastWiFiDisconnect=now;
@@ -584,5 +839,6 @@ void loop() {
       digitalWrite(SLED, HIGH);   // Turn the Status Led off
     }
   } 
+  publishSensor();   // while the broker is not reachable the newest state is queued and sent after reconnect
   delay(update_interval_loop); // 25 ms (short because of tiltu) (1.5 degrees in in 25 ms)
 }
@@ -28,6 +28,10 @@ char _subscribe_position2_[] = "blinds/cover2/position";
 char _subscribe_tilt1_[] = "blinds/cover1/tilt";
 char _subscribe_tilt2_[] = "blinds/cover2/tilt";
 
+// comment for per-topic state messages (position1/2, tilt1/2), uncomment to publish one JSON message per device
+//#define _json_state_ 1
+char _publish_state_[] = "blinds/cover/json-state";  // default - can be changed via web
+
 char _subscribe_calibrate_[] = "blinds/cover/calibrate";
 char _subscribe_reset_[] = "blinds/cover/reset";
 char _subscribe_reboot_[] = "blinds/cover/reboot";
@@ -43,11 +47,34 @@ char _subscribe_reboot_[] = "blinds/cover/reboot";
 #define _reverse_position_mapping_ 1
 #define _auto_hold_buttons_ 1
 
+// MQTT packet buffers (bytes) - received commands are short, the longest sent message is the JSON state
+#define mqtt_rx_buffer 128
+#define mqtt_tx_buffer 256
+
+// uncomment to connect with MQTT 5 - topic aliases for the state topics and a session the broker keeps
+// for mqtt_session_expiry seconds, so the subscriptions survive a short disconnect
+//#define _mqtt5_ 1
+#define mqtt_session_expiry 300
+
+// uncomment to connect to the broker with TLS (BearSSL) - the session is resumed on reconnect, so only the first
+// connection does the full handshake. With a fingerprint (SHA1 of the broker certificate, "AA:BB:..") the certificate
+// is pinned, without it the certificate is not checked
+//#define _mqtt_tls_ 1
+#define tls_fragment 512  // max fragment length asked from the broker (MFLN) - smaller TLS buffers
+char _mqtt_fingerprint_[] = "";
+
+// QoS of the state messages - with 1 they are repeated after a reconnect until the broker confirms them
+#define publish_qos 1
+
 char payload_open[] = "open";
 char payload_close[] = "close";
 char payload_stop[] = "stop";
 
 
+// Number of flash sectors (4 kB, from the file system area) used as a ring for the status journal
+// Needs a flash layout with file system (e.g. 1M (64K SPIFFS)), with no file system the status is saved to EEPROM
+#define _status_journal_sectors_ 4
+
 // Change these for your WIFI, IP and MQTT
 char _ssid1_[] = "wifi_ssid";
 char _password1_[] = "wifi_password";
@@ -55,6 +82,11 @@ char OTA_password[] = "OTApassword"; // Only accepts [a-z][A-Z][0-9]
 char _mqtt_server_[] = "xxx.xxx.xxx.xxx";
 char _mqtt_user_[] = "mqtt_user";
 char _mqtt_password_[] = "mqtt_password";
+#ifdef _mqtt_tls_
+  #define _mqtt_port_ 8883
+#else
+  #define _mqtt_port_ 1883
+#endif
 
 
 char movementUp[] ="up";
@@ -64,8 +96,24 @@ char movementDownVent[] = "down (vent)";
 char movementStopped[] = "stopped";
 
 #define update_interval_loop 50
-#define update_interval_active 1000
-#define update_interval_passive 300000
+
+// Network reconnects - the wait after a failed attempt doubles up to the max
+#define wifi_connect_timeout 15000  // one attempt (association and DHCP)
+#define wifi_backoff_min 1000
+#define wifi_backoff_max 60000
+#define wifi_default_attempts 2     // after this many failures with no connection since boot, the default config is loaded
+#define mqtt_backoff_min 2000
+#define mqtt_backoff_max 60000
+#define mqtt_tcp_timeout 2000       // TCP connect to the broker, CONNACK is then waited for in the background
+#define mqtt_socket_timeout 5       // s - CONNACK, rest of a started packet
+#define mqtt_keepalive 15           // s - a ping is sent only when nothing else was sent for this long
+#define update_interval_active 1000 // minimum time between two updates while the position is changing
+#define update_interval_heartbeat 300000 // resend the state if nothing has changed for this long
+#define update_interval_events 10000 // status (WiFi, memory, MQTT) pushed to the open web pages
+
+// Publish the position/tilt only when it changed at least by this much (in %)
+#define publish_deadband_position 1
+#define publish_deadband_tilt 1
 
 //Ignore pulses shorter than 100ms
 #define _button_delay_ 100
@@ -134,6 +182,10 @@ struct configuration {
   byte GPIO_KEY2;
   byte GPIO_KEY3;
   byte GPIO_KEY4;
+  // not in the configuration saved without header (LEGACY_CONFIG_SIZE) - add new fields only at the end
+  char publish_state[50];
+  unsigned int mqtt_port;
+  char mqtt_fingerprint[60];
 };
 
 #endif
@@ -3,6 +3,42 @@
 
 #include <EEPROM.h>
 
+#define CONFIG_MAGIC 0xB11D
+#define CONFIG_VERSION 2  // 1 - struct configuration image, 2 - tagged fields (config_fields)
+
+// Stored in front of the configuration in EEPROM
+struct config_header {
+  uint16_t magic;
+  uint16_t version;   // CONFIG_VERSION of the firmware that saved it
+  uint16_t size;      // length of the stored configuration
+  uint16_t reserved;
+  uint32_t crc;       // header (without crc) and configuration
+};
+
+enum config_type : uint8_t { CFG_NUMBER, CFG_STRING, CFG_BOOL };  // bool is stored as a number
+
+struct config_field {
+  uint8_t id;       // stored in EEPROM and posted by the configure page - never change or reuse, next one is the last +1
+  uint8_t type;
+  uint16_t offset;  // in struct configuration
+  uint16_t size;
+  uint32_t max;     // highest value accepted from the web (numbers)
+  char name[30];    // on the web (configure page, readConfig, saveConfig)
+};
+
+#define CONFIG_FIELD(id,type,name,max) {id,type,offsetof(configuration,name),sizeof(((configuration*)0)->name),max,#name}
+
+#define CONFIG_HEADER_OFFSET 0
+#define CONFIG_OFFSET (CONFIG_HEADER_OFFSET+sizeof(config_header))
+#define STATUS_OFFSET 2048  // status saved here when the journal is not available
+// sizeof(configuration) of the firmware that saved no header (configuration at 0, CRC and status behind it).
+// Frozen - fields added to the struct later are not in those images
+#define LEGACY_CONFIG_SIZE 892
+#define EEPROM_SIZE (STATUS_OFFSET+32)
+
+extern "C" uint32_t _EEPROM_start;
+#define EEPROM_PHYS_ADDR ((uint32_t)&_EEPROM_start-0x40200000)
+
 void openMemory();
 void saveStatus();
 void loadStatus();
@@ -10,5 +46,9 @@ void saveConfig();
 void loadConfig();
 void copyConfig(configuration* from,configuration* to);
 void defaultConfig(configuration* c);
+boolean configField(unsigned int i,config_field* f);
+boolean configFieldById(unsigned int id,config_field* f);
+unsigned long crc32(const byte* data,int s);
+unsigned long crc32_update(unsigned long crc,const byte* data,int s);
 
 #endif
@@ -1,5 +1,6 @@
 #include "config.h"
 #include "crc.h"
+#include "journal.h"
 
 struct shutter_position {
     int r1_position;
@@ -8,31 +9,275 @@ struct shutter_position {
     int r2_tilt;
 } p;
 
+// Every field of struct configuration is stored as [id][length][data] - new fields get a new id,
+// ids of removed fields are never reused. Unknown ids are skipped, missing fields keep the default value
+constexpr config_field config_fields[] PROGMEM = {
+  CONFIG_FIELD(1,CFG_BOOL,tilt,1),
+  CONFIG_FIELD(2,CFG_BOOL,two_covers,1),
+  CONFIG_FIELD(3,CFG_BOOL,vents,1),
+  CONFIG_FIELD(4,CFG_BOOL,reverse_position_mapping,1),
+  CONFIG_FIELD(5,CFG_BOOL,auto_hold_buttons,1),
+  CONFIG_FIELD(6,CFG_STRING,host_name,0),
+  CONFIG_FIELD(7,CFG_STRING,wifi_ssid1,0),
+  CONFIG_FIELD(8,CFG_STRING,wifi_password1,0),
+  CONFIG_FIELD(9,CFG_STRING,wifi_ssid2,0),
+  CONFIG_FIELD(10,CFG_STRING,wifi_password2,0),
+  CONFIG_FIELD(11,CFG_BOOL,wifi_multi,1),
+  CONFIG_FIELD(12,CFG_STRING,mqtt_server,0),
+  CONFIG_FIELD(13,CFG_STRING,mqtt_user,0),
+  CONFIG_FIELD(14,CFG_STRING,mqtt_password,0),
+  CONFIG_FIELD(15,CFG_STRING,publish_position1,0),
+  CONFIG_FIELD(16,CFG_STRING,publish_position2,0),
+  CONFIG_FIELD(17,CFG_STRING,publish_tilt1,0),
+  CONFIG_FIELD(18,CFG_STRING,publish_tilt2,0),
+  CONFIG_FIELD(19,CFG_STRING,subscribe_command1,0),
+  CONFIG_FIELD(20,CFG_STRING,subscribe_command2,0),
+  CONFIG_FIELD(21,CFG_STRING,subscribe_position1,0),
+  CONFIG_FIELD(22,CFG_STRING,subscribe_position2,0),
+  CONFIG_FIELD(23,CFG_STRING,subscribe_tilt1,0),
+  CONFIG_FIELD(24,CFG_STRING,subscribe_tilt2,0),
+  CONFIG_FIELD(25,CFG_STRING,subscribe_calibrate,0),
+  CONFIG_FIELD(26,CFG_STRING,subscribe_reboot,0),
+  CONFIG_FIELD(27,CFG_STRING,subscribe_reset,0),
+  CONFIG_FIELD(28,CFG_NUMBER,Shutter1_duration_down,120000),
+  CONFIG_FIELD(29,CFG_NUMBER,Shutter2_duration_down,120000),
+  CONFIG_FIELD(30,CFG_NUMBER,Shutter1_duration_up,120000),
+  CONFIG_FIELD(31,CFG_NUMBER,Shutter2_duration_up,120000),
+  CONFIG_FIELD(32,CFG_NUMBER,Shutter1_duration_vents_down,120000),
+  CONFIG_FIELD(33,CFG_NUMBER,Shutter2_duration_vents_down,120000),
+  CONFIG_FIELD(34,CFG_NUMBER,Shutter1_duration_tilt,120000),
+  CONFIG_FIELD(35,CFG_NUMBER,Shutter2_duration_tilt,120000),
+  CONFIG_FIELD(36,CFG_NUMBER,GPIO_KEY1,16),
+  CONFIG_FIELD(37,CFG_NUMBER,GPIO_KEY2,16),
+  CONFIG_FIELD(38,CFG_NUMBER,GPIO_KEY3,16),
+  CONFIG_FIELD(39,CFG_NUMBER,GPIO_KEY4,16),
+  CONFIG_FIELD(40,CFG_STRING,publish_state,0),
+  CONFIG_FIELD(41,CFG_NUMBER,mqtt_port,65535),
+  CONFIG_FIELD(42,CFG_STRING,mqtt_fingerprint,0)
+};
+#define CONFIG_FIELDS (sizeof(config_fields)/sizeof(config_field))
+
+// i-th field of the table (false after the last one)
+boolean configField(unsigned int i,config_field* f) {
+  if (i>=CONFIG_FIELDS) return false;
+  memcpy_P(f,&config_fields[i],sizeof(config_field));
+  return true;
+}
+
+// Id i+1 is config_fields[i] - found without searching the table
+constexpr bool configFieldsOrdered(unsigned int i) {
+  return i>=CONFIG_FIELDS || (config_fields[i].id==i+1 && configFieldsOrdered(i+1));
+}
+static_assert(configFieldsOrdered(0),"config_fields have to be ordered by id, without gaps");
+
+// Stored length fits the length byte, numbers are read into 32 bits
+constexpr bool configFieldsStorable(unsigned int i) {
+  return i>=CONFIG_FIELDS || ((config_fields[i].type==CFG_STRING ? config_fields[i].size-1<=255 : config_fields[i].size<=4) && configFieldsStorable(i+1));
+}
+static_assert(configFieldsStorable(0),"string fields longer than 255 or numbers wider than 4 bytes can not be stored");
+
+// Longest configuration writeConfig() saves - every string at full length
+constexpr unsigned int configFieldsSize(unsigned int i) {
+  return i>=CONFIG_FIELDS ? 1 : 2+(config_fields[i].type==CFG_STRING ? config_fields[i].size-1 : config_fields[i].size)+configFieldsSize(i+1);
+}
+static_assert(CONFIG_OFFSET+configFieldsSize(0)<=STATUS_OFFSET,"configuration does not fit in front of the saved status");
+
+// Field with the id (false for an unknown one - e.g. saved by a newer firmware)
+boolean configFieldById(unsigned int id,config_field* f) {
+  if (id==0) return false;
+  return configField(id-1,f);
+}
+
+uint32_t flash_cache_block=0xFFFFFFFF;
+uint32_t flash_cache[8];
+
 void openMemory() {
-    EEPROM.begin(sizeof(configuration)+sizeof(unsigned long)+sizeof(shutter_position)+sizeof(unsigned long));
+    journalOpen();
+}
+
+/**** Reads the EEPROM sector straight from the flash (no EEPROM.begin() copy in RAM) ****/
+byte flashByte(uint32_t offset) {
+  uint32_t block=offset & ~(sizeof(flash_cache)-1);
+  if (block!=flash_cache_block) {
+    ESP.flashRead(EEPROM_PHYS_ADDR+block,flash_cache,sizeof(flash_cache));
+    flash_cache_block=block;
+  }
+  return ((byte*)flash_cache)[offset-block];
+}
+
+void flashBytes(uint32_t offset,byte* data,int s) {
+  for (int index = 0 ; index < s ; ++index) {
+    data[index]=flashByte(offset+index);
+  }
+}
+
+unsigned long flashCrc(unsigned long crc,uint32_t offset,int s) {
+  byte value;
+  for (int index = 0 ; index < s ; ++index) {
+    value=flashByte(offset+index);
+    crc=crc32_update(crc,&value,1);
+  }
+  return crc;
+}
+
+/**** EEPROM library only while writing - the buffer is released again ****/
+void beginWrite() {
+  EEPROM.begin(EEPROM_SIZE);
+}
+
+void endWrite() {
+  EEPROM.commit();  // everything in one sector write
+  EEPROM.end();
+  flash_cache_block=0xFFFFFFFF;
+}
+
+// Length of a field of cfg in the stored configuration
+uint8_t fieldLength(const config_field* f) {
+  const byte* data=(const byte*)&cfg+f->offset;
+  return (f->type==CFG_STRING)?strnlen((const char*)data,f->size-1):f->size;
+}
+
+// Header writeConfig() saves for cfg - compared with the stored one, the same configuration is not written again
+void configHeader(config_header* h) {
+  config_field f;
+  byte tag[2];
+  unsigned long crc;
+
+  h->magic=CONFIG_MAGIC;
+  h->version=CONFIG_VERSION;
+  h->size=1;  // end
+  h->reserved=0;
+  for (unsigned int i=0; configField(i,&f); i++) h->size+=2+fieldLength(&f);
+  crc=crc32_update(~0L,(const byte*)h,sizeof(config_header)-sizeof(h->crc));
+  for (unsigned int i=0; configField(i,&f); i++) {
+    tag[0]=f.id;
+    tag[1]=fieldLength(&f);
+    crc=crc32_update(crc,tag,2);
+    crc=crc32_update(crc,(const byte*)&cfg+f.offset,tag[1]);
+  }
+  tag[0]=0;
+  h->crc=crc32_update(crc,tag,1);
+}
+
+void writeConfig() {
+  config_header h;
+  config_field f;
+  uint16_t pos=CONFIG_OFFSET;
+  byte* eeprom=EEPROM.getDataPtr();
+
+  for (unsigned int i=0; configField(i,&f); i++) {
+    uint8_t len=fieldLength(&f);
+    eeprom[pos++]=f.id;
+    eeprom[pos++]=len;
+    memcpy(eeprom+pos,(const byte*)&cfg+f.offset,len);
+    pos+=len;
+  }
+  eeprom[pos++]=0;  // end
+  configHeader(&h);
+  EEPROM.put(CONFIG_HEADER_OFFSET,h);
 }
 
 void saveConfig() {
-  EEPROM.put(0,cfg);
-  EEPROM.commit();
-  unsigned long check=eeprom_crc(0,sizeof(configuration));
-  EEPROM.put(sizeof(configuration),check);
-  EEPROM.commit();  
+  beginWrite();
+  writeConfig();
+  endWrite();
+}
+
+/**** One stored field to cfg - strings are cut to the current size, numbers widened/narrowed (little endian) ****/
+void readField(const config_field* f,uint32_t offset,uint8_t len) {
+  byte* data=(byte*)&cfg+f->offset;
+  if (f->type==CFG_STRING) {
+    memset(data,0,f->size);
+    flashBytes(offset,data,min((int)len,f->size-1));
+  } else {
+    uint32_t value=0;
+    for (int i=0; i<len && i<4; i++) {
+      value|=(uint32_t)flashByte(offset+i)<<(8*i);
+    }
+    for (int i=0; i<f->size; i++) {
+      data[i]=(value>>(8*i)) & 0xff;
+    }
+  }
+}
+
+void readFields(config_header* h) {
+  config_field f;
+  uint32_t pos=CONFIG_OFFSET;
+  uint32_t end=CONFIG_OFFSET+h->size;
+
+  while (pos+2<=end) {
+    uint8_t id=flashByte(pos);
+    uint8_t len=flashByte(pos+1);
+    if (id==0) break;
+    pos+=2;
+    if (configFieldById(id,&f)) readField(&f,pos,len);
+    pos+=len;
+  }
+}
+
+/**** Configuration saved by older firmware as a struct image - take what is still valid ****/
+void migrateConfig(config_header* h) {
+  switch (h->version) {
+    case 1:
+      // Version 1 - struct configuration behind the header
+      flashBytes(CONFIG_OFFSET,(byte*)&cfg,min((int)h->size,(int)sizeof(configuration)));
+      break;
+  }
+}
+
+// Moves the saved status block (used when the journal is not available) from an older layout
+void moveStatus(uint32_t offset) {
+  byte status[sizeof(shutter_position)+sizeof(unsigned long)];
+  flashBytes(offset,status,sizeof(status));
+  EEPROM.put(STATUS_OFFSET,status);
 }
 
+// The header-less image is the old struct with the fields at the same place - still the start of struct configuration
+static_assert(((offsetof(configuration,GPIO_KEY4)+sizeof(byte)+3)&~3)==LEGACY_CONFIG_SIZE,"fields of the legacy configuration moved");
+// Fields added since then are behind it - a converted image leaves them at the default values
+static_assert(offsetof(configuration,publish_state)>=LEGACY_CONFIG_SIZE,"new configuration fields have to be added at the end");
+
 void loadConfig() {
-  unsigned long check1;
-  unsigned long check2;
+  config_header h;
+  unsigned long legacy_check;
   
-  EEPROM.get(0,cfg);
-  EEPROM.get(sizeof(configuration),check2);
-  check1=eeprom_crc(0,sizeof(configuration));
-  if (check1!=check2) {  
-    defaultConfig(&cfg);
+  flashBytes(CONFIG_HEADER_OFFSET,(byte*)&h,sizeof(config_header));
+  flashBytes(LEGACY_CONFIG_SIZE,(byte*)&legacy_check,sizeof(unsigned long));
+  defaultConfig(&cfg);
+  if (h.magic==CONFIG_MAGIC && h.size<=STATUS_OFFSET-CONFIG_OFFSET && h.crc==flashCrc(crc32_update(~0L,(const byte*)&h,sizeof(config_header)-sizeof(h.crc)),CONFIG_OFFSET,h.size)) {
+    if (h.version>=2) {
+      // Tagged fields - unknown ids (a newer firmware) are skipped, missing ones keep the default value
+      config_header saved;
+      readFields(&h);
+      configHeader(&saved);
+      if (h.version>CONFIG_VERSION) {
+        // Left as it is - the newer firmware finds its fields again after an upgrade
+        crcStatus+="Config of v"+String(h.version)+" read. ";
+      } else if (saved.size!=h.size || saved.crc!=h.crc) {
+        saveConfig();
+        crcStatus+="Config updated. ";
+      } else {
+        crcStatus+="CRC config OK! ";
+      }
+    } else {
+      migrateConfig(&h);
+      beginWrite();
+      moveStatus(CONFIG_OFFSET+h.size);
+      writeConfig();
+      endWrite();
+      crcStatus+="Config migrated from v"+String(h.version)+". ";
+    }
+  } else if (legacy_check==flashCrc(~0L,0,LEGACY_CONFIG_SIZE)) {
+    // Saved without header (configuration at 0, CRC behind it, status behind the CRC)
+    flashBytes(0,(byte*)&cfg,LEGACY_CONFIG_SIZE);
+    beginWrite();
+    moveStatus(LEGACY_CONFIG_SIZE+sizeof(unsigned long));
+    writeConfig();
+    endWrite();
+    crcStatus+="CRC config OK (converted)! ";
+  } else {  
     saveConfig();
     crcStatus+="CRC config failed. ";
-  } else {
-    crcStatus+="CRC config OK! ";
   }
 }
 
@@ -67,8 +312,11 @@ void defaultConfig(configuration* c) {
   strncpy(c->mqtt_server,_mqtt_server_,24);
   strncpy(c->mqtt_user,_mqtt_user_,24);
   strncpy(c->mqtt_password,_mqtt_password_,24);
+  c->mqtt_port=_mqtt_port_;
+  strncpy(c->mqtt_fingerprint,_mqtt_fingerprint_,59);
   strncpy(c->publish_position1,_publish_position1_,49);
   strncpy(c->publish_position2,_publish_position2_,49);
+  strncpy(c->publish_state,_publish_state_,49);
   strncpy(c->subscribe_command1,_subscribe_command1_,49);
   strncpy(c->subscribe_command2,_subscribe_command2_,49);
   strncpy(c->subscribe_position1,_subscribe_position1_,49);
@@ -122,8 +370,11 @@ void copyConfig(configuration* from,configuration* to) {
   strncpy(to->mqtt_server,from->mqtt_server,24);
   strncpy(to->mqtt_user,from->mqtt_user,24);
   strncpy(to->mqtt_password,from->mqtt_password,24);
+  to->mqtt_port=from->mqtt_port;
+  strncpy(to->mqtt_fingerprint,from->mqtt_fingerprint,59);
   strncpy(to->publish_position1,from->publish_position1,49);
   strncpy(to->publish_position2,from->publish_position2,49);
+  strncpy(to->publish_state,from->publish_state,49);
   strncpy(to->subscribe_command1,from->subscribe_command1,49);
   strncpy(to->subscribe_command2,from->subscribe_command2,49);
   strncpy(to->subscribe_position1,from->subscribe_position1,49);
@@ -156,21 +407,42 @@ void saveStatus() {
   p.r2_position=r2.getPosition();
   p.r1_tilt=r1.getTilt();
   p.r2_tilt=r2.getTilt();
-  EEPROM.put(sizeof(configuration)+sizeof(unsigned long),p);
-  EEPROM.commit();
-  unsigned long check=eeprom_crc(sizeof(configuration)+sizeof(unsigned long),sizeof(shutter_position));
-  EEPROM.put(sizeof(configuration)+sizeof(unsigned long)+sizeof(shutter_position),check);
-  EEPROM.commit();
+
+  // One record appended to the flash journal (sector erased only once per sector full of records)
+  journal_record j;
+  j.r1_position=p.r1_position;
+  j.r2_position=p.r2_position;
+  j.r1_tilt=p.r1_tilt;
+  j.r2_tilt=p.r2_tilt;
+  if (journalAppend(&j))
+    return;
+
+  // No journal (no file system area in the flash layout) - rewrite the EEPROM sector
+  unsigned long check=crc32((const byte*)&p,sizeof(shutter_position));
+  beginWrite();
+  EEPROM.put(STATUS_OFFSET,p);
+  EEPROM.put(STATUS_OFFSET+sizeof(shutter_position),check);
+  endWrite();
 }
 
 void loadStatus() {
   unsigned long check1;
   unsigned long check2;
-  
-  EEPROM.get(sizeof(configuration)+sizeof(unsigned long),p);
-  EEPROM.get(sizeof(configuration)+sizeof(unsigned long)+sizeof(shutter_position),check2);
+  journal_record j;
 
-  check1=eeprom_crc(sizeof(configuration)+sizeof(unsigned long),sizeof(shutter_position));
+  if (journalLoad(&j)) {
+    p.r1_position=j.r1_position;
+    p.r2_position=j.r2_position;
+    p.r1_tilt=j.r1_tilt;
+    p.r2_tilt=j.r2_tilt;
+    check1=check2=0;
+    crcStatus += "Journal ";
+  } else {
+    // Nothing in the journal yet - status saved by older firmware (or journal not available)
+    flashBytes(STATUS_OFFSET,(byte*)&p,sizeof(shutter_position));
+    flashBytes(STATUS_OFFSET+sizeof(shutter_position),(byte*)&check2,sizeof(unsigned long));
+    check1=crc32((const byte*)&p,sizeof(shutter_position));
+  }
   if (check1==check2) {
     #ifdef DEBUG
       Serial.println("EEPROM CRC check OK, reading stored values.");
@@ -205,22 +477,82 @@ void loadStatus() {
 
 /**** Vypocita CRC ulozenych hodnot ****/ 
 
-unsigned long eeprom_crc(int o,int s) {
-  const unsigned long crc_table[16] = {
-    0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
-    0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
-    0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
-    0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c
-  };
-
-  unsigned long crc = ~0L;
-  byte value;
+// CRC32 (0xEDB88320) one byte per step. Every step is inverted - same values as the original nibble-table version,
+// so the CRCs stored by older firmware stay valid
+const uint32_t crc_table[256] PROGMEM = {
+    0x00000000, 0x77073096, 0xee0e612c, 0x990951ba,
+    0x076dc419, 0x706af48f, 0xe963a535, 0x9e6495a3,
+    0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988,
+    0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91,
+    0x1db71064, 0x6ab020f2, 0xf3b97148, 0x84be41de,
+    0x1adad47d, 0x6ddde4eb, 0xf4d4b551, 0x83d385c7,
+    0x136c9856, 0x646ba8c0, 0xfd62f97a, 0x8a65c9ec,
+    0x14015c4f, 0x63066cd9, 0xfa0f3d63, 0x8d080df5,
+    0x3b6e20c8, 0x4c69105e, 0xd56041e4, 0xa2677172,
+    0x3c03e4d1, 0x4b04d447, 0xd20d85fd, 0xa50ab56b,
+    0x35b5a8fa, 0x42b2986c, 0xdbbbc9d6, 0xacbcf940,
+    0x32d86ce3, 0x45df5c75, 0xdcd60dcf, 0xabd13d59,
+    0x26d930ac, 0x51de003a, 0xc8d75180, 0xbfd06116,
+    0x21b4f4b5, 0x56b3c423, 0xcfba9599, 0xb8bda50f,
+    0x2802b89e, 0x5f058808, 0xc60cd9b2, 0xb10be924,
+    0x2f6f7c87, 0x58684c11, 0xc1611dab, 0xb6662d3d,
+    0x76dc4190, 0x01db7106, 0x98d220bc, 0xefd5102a,
+    0x71b18589, 0x06b6b51f, 0x9fbfe4a5, 0xe8b8d433,
+    0x7807c9a2, 0x0f00f934, 0x9609a88e, 0xe10e9818,
+    0x7f6a0dbb, 0x086d3d2d, 0x91646c97, 0xe6635c01,
+    0x6b6b51f4, 0x1c6c6162, 0x856530d8, 0xf262004e,
+    0x6c0695ed, 0x1b01a57b, 0x8208f4c1, 0xf50fc457,
+    0x65b0d9c6, 0x12b7e950, 0x8bbeb8ea, 0xfcb9887c,
+    0x62dd1ddf, 0x15da2d49, 0x8cd37cf3, 0xfbd44c65,
+    0x4db26158, 0x3ab551ce, 0xa3bc0074, 0xd4bb30e2,
+    0x4adfa541, 0x3dd895d7, 0xa4d1c46d, 0xd3d6f4fb,
+    0x4369e96a, 0x346ed9fc, 0xad678846, 0xda60b8d0,
+    0x44042d73, 0x33031de5, 0xaa0a4c5f, 0xdd0d7cc9,
+    0x5005713c, 0x270241aa, 0xbe0b1010, 0xc90c2086,
+    0x5768b525, 0x206f85b3, 0xb966d409, 0xce61e49f,
+    0x5edef90e, 0x29d9c998, 0xb0d09822, 0xc7d7a8b4,
+    0x59b33d17, 0x2eb40d81, 0xb7bd5c3b, 0xc0ba6cad,
+    0xedb88320, 0x9abfb3b6, 0x03b6e20c, 0x74b1d29a,
+    0xead54739, 0x9dd277af, 0x04db2615, 0x73dc1683,
+    0xe3630b12, 0x94643b84, 0x0d6d6a3e, 0x7a6a5aa8,
+    0xe40ecf0b, 0x9309ff9d, 0x0a00ae27, 0x7d079eb1,
+    0xf00f9344, 0x8708a3d2, 0x1e01f268, 0x6906c2fe,
+    0xf762575d, 0x806567cb, 0x196c3671, 0x6e6b06e7,
+    0xfed41b76, 0x89d32be0, 0x10da7a5a, 0x67dd4acc,
+    0xf9b9df6f, 0x8ebeeff9, 0x17b7be43, 0x60b08ed5,
+    0xd6d6a3e8, 0xa1d1937e, 0x38d8c2c4, 0x4fdff252,
+    0xd1bb67f1, 0xa6bc5767, 0x3fb506dd, 0x48b2364b,
+    0xd80d2bda, 0xaf0a1b4c, 0x36034af6, 0x41047a60,
+    0xdf60efc3, 0xa867df55, 0x316e8eef, 0x4669be79,
+    0xcb61b38c, 0xbc66831a, 0x256fd2a0, 0x5268e236,
+    0xcc0c7795, 0xbb0b4703, 0x220216b9, 0x5505262f,
+    0xc5ba3bbe, 0xb2bd0b28, 0x2bb45a92, 0x5cb36a04,
+    0xc2d7ffa7, 0xb5d0cf31, 0x2cd99e8b, 0x5bdeae1d,
+    0x9b64c2b0, 0xec63f226, 0x756aa39c, 0x026d930a,
+    0x9c0906a9, 0xeb0e363f, 0x72076785, 0x05005713,
+    0x95bf4a82, 0xe2b87a14, 0x7bb12bae, 0x0cb61b38,
+    0x92d28e9b, 0xe5d5be0d, 0x7cdcefb7, 0x0bdbdf21,
+    0x86d3d2d4, 0xf1d4e242, 0x68ddb3f8, 0x1fda836e,
+    0x81be16cd, 0xf6b9265b, 0x6fb077e1, 0x18b74777,
+    0x88085ae6, 0xff0f6a70, 0x66063bca, 0x11010b5c,
+    0x8f659eff, 0xf862ae69, 0x616bffd3, 0x166ccf45,
+    0xa00ae278, 0xd70dd2ee, 0x4e048354, 0x3903b3c2,
+    0xa7672661, 0xd06016f7, 0x4969474d, 0x3e6e77db,
+    0xaed16a4a, 0xd9d65adc, 0x40df0b66, 0x37d83bf0,
+    0xa9bcae53, 0xdebb9ec5, 0x47b2cf7f, 0x30b5ffe9,
+    0xbdbdf21c, 0xcabac28a, 0x53b39330, 0x24b4a3a6,
+    0xbad03605, 0xcdd70693, 0x54de5729, 0x23d967bf,
+    0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94,
+    0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d
+};
 
+unsigned long crc32_update(unsigned long crc,const byte* data,int s) {
   for (int index = 0 ; index < s  ; ++index) {
-    value = EEPROM.read(o+index);
-    crc = crc_table[(crc ^ value) & 0x0f] ^ (crc >> 4);
-    crc = crc_table[(crc ^ (value >> 4)) & 0x0f] ^ (crc >> 4);
-    crc = ~crc;
+    crc = ~(pgm_read_dword(&crc_table[(crc ^ data[index]) & 0xff]) ^ (crc >> 8));
   }
   return crc;
 }
+
+unsigned long crc32(const byte* data,int s) {
+  return crc32_update(~0L,data,s);
+}
@@ -0,0 +1,38 @@
+#!/usr/bin/env python3
+"""
+Compresses the web pages and writes them to ../web_pages.h as PROGMEM arrays.
+Run it after every change of the html files:
+  python3 build_pages.py
+The ETag is a hash of the compressed page, so browsers reload it only when it changes.
+"""
+import gzip
+import hashlib
+import os
+
+PAGES = [
+    ("MAIN_page", "main.html"),
+    ("CONFIGURE_page", "configure.html"),
+]
+
+here = os.path.dirname(os.path.abspath(__file__))
+out = [
+    "// Generated by html/build_pages.py - do not edit, change the html files and run the script",
+    "#ifndef WEB_PAGES_H",
+    "#define WEB_PAGES_H",
+    "",
+]
+for name, file_name in PAGES:
+    with open(os.path.join(here, file_name), "rb") as f:
+        html = f.read()
+    data = gzip.compress(html, compresslevel=9, mtime=0)
+    etag = hashlib.sha1(data).hexdigest()[:16]
+    out.append("// %s: %d bytes, %d bytes compressed" % (file_name, len(html), len(data)))
+    out.append('#define %s_etag "\\"%s\\""' % (name, etag))
+    out.append("const uint8_t %s_gz[] PROGMEM = {" % name)
+    for i in range(0, len(data), 16):
+        out.append("  " + ",".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    out.append("};")
+    out.append("")
+out.append("#endif")
+with open(os.path.join(here, "..", "web_pages.h"), "w") as f:
+    f.write("\n".join(out) + "\n")
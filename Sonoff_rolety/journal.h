@@ -0,0 +1,18 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+// One saved status (shutter positions and tilts). 16 bytes - flash is written in aligned 4 byte words
+struct journal_record {
+  uint32_t sequence;  // 0xFFFFFFFF = empty (erased flash)
+  int16_t r1_position;
+  int16_t r2_position;
+  int16_t r1_tilt;
+  int16_t r2_tilt;
+  uint32_t crc;
+};
+
+boolean journalOpen();
+boolean journalLoad(journal_record* r);
+boolean journalAppend(journal_record* r);
+
+#endif
@@ -0,0 +1,93 @@
+#include "config.h"
+#include "crc.h"
+#include "journal.h"
+#include <flash_hal.h>
+
+/*
+ Append-only journal of the shutter status in the (unused) file system area of the flash.
+ Every save writes one small record to the next free slot - no sector erase, no EEPROM.commit().
+ The sectors are used as a ring. A sector is erased only when the journal reaches it again (all records in it are old by then).
+ At boot, the record with the highest sequence number and a valid CRC is the current status.
+*/
+
+#define JOURNAL_RECORDS_PER_SECTOR (FLASH_SECTOR_SIZE/sizeof(journal_record))
+
+uint32_t journal_start=0;     // flash address of the first sector
+uint16_t journal_sectors=0;   // 0 = journal not available (no file system area)
+uint16_t journal_slot=0;      // next slot to write (across all sectors)
+int32_t journal_newest=-1;    // slot of the newest valid record (-1 = none)
+uint32_t journal_sequence=0;  // sequence number of the newest record
+
+uint32_t journalAddress(uint16_t slot) {
+  return journal_start+(uint32_t)slot*sizeof(journal_record);
+}
+
+uint32_t journalCrc(journal_record* r) {
+  return crc32((byte*)r,sizeof(journal_record)-sizeof(r->crc));
+}
+
+boolean journalEmpty(journal_record* r) {
+  uint32_t* w=(uint32_t*)r;
+  for (unsigned int i=0; i<sizeof(journal_record)/sizeof(uint32_t); i++) {
+    if (w[i]!=0xFFFFFFFF) return false;
+  }
+  return true;
+}
+
+/**** Finds the newest record and the next free slot ****/
+boolean journalOpen() {
+  journal_record r;
+  uint16_t slots;
+
+  journal_start=FS_PHYS_ADDR;
+  journal_sectors=min((uint32_t)_status_journal_sectors_,(uint32_t)(FS_PHYS_SIZE/FLASH_SECTOR_SIZE));
+  if (journal_sectors<2) {
+    journal_sectors=0;
+    return false;
+  }
+  slots=journal_sectors*JOURNAL_RECORDS_PER_SECTOR;
+  journal_newest=-1;
+  journal_sequence=0;
+  for (uint16_t slot=0; slot<slots; slot++) {
+    ESP.flashRead(journalAddress(slot),(uint32_t*)&r,sizeof(journal_record));
+    if (journalEmpty(&r)) {
+      slot=(slot/JOURNAL_RECORDS_PER_SECTOR+1)*JOURNAL_RECORDS_PER_SECTOR-1; // rest of the sector is empty
+      continue;
+    }
+    if (r.crc==journalCrc(&r) && (journal_newest<0 || r.sequence>journal_sequence)) {
+      journal_sequence=r.sequence;
+      journal_newest=slot;
+    }
+  }
+  // Continue after the newest record, skip anything that is not erased (interrupted write)
+  journal_slot=(journal_newest+1)%slots;
+  while (journal_slot%JOURNAL_RECORDS_PER_SECTOR!=0) {
+    ESP.flashRead(journalAddress(journal_slot),(uint32_t*)&r,sizeof(journal_record));
+    if (journalEmpty(&r)) break;
+    journal_slot=(journal_slot+1)%slots;
+  }
+  #ifdef DEBUG
+    Serial.printf("Journal: %d sectors, last record %d, sequence %u\n",journal_sectors,journal_newest,journal_sequence);
+  #endif
+  return true;
+}
+
+boolean journalLoad(journal_record* r) {
+  if (journal_sectors==0 || journal_newest<0) return false;
+  ESP.flashRead(journalAddress(journal_newest),(uint32_t*)r,sizeof(journal_record));
+  return (r->crc==journalCrc(r));
+}
+
+boolean journalAppend(journal_record* r) {
+  if (journal_sectors==0) return false;
+  if (journal_slot%JOURNAL_RECORDS_PER_SECTOR==0) {
+    // Entering the oldest sector - recycle it
+    if (!ESP.flashEraseSector(journalAddress(journal_slot)/FLASH_SECTOR_SIZE)) return false;
+  }
+  r->sequence=++journal_sequence;
+  r->crc=journalCrc(r);
+  boolean ok=ESP.flashWrite(journalAddress(journal_slot),(uint32_t*)r,sizeof(journal_record));
+  if (ok) journal_newest=journal_slot;
+  journal_slot=(journal_slot+1)%(journal_sectors*JOURNAL_RECORDS_PER_SECTOR);
+  return ok;
+}
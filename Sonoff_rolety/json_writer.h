@@ -0,0 +1,49 @@
+#ifdef _WEB_
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <ESP8266WebServer.h>
+
+// Writes JSON into a fixed buffer, no heap. Keys are in flash (PSTR).
+// With a server the full buffer is sent as a chunk of the response (and reused), without it the output stops when the buffer is full
+class JsonWriter {
+  private:
+    char* buf;
+    size_t size;
+    size_t len;
+    boolean comma;    // next value needs a separator
+    boolean overflow;
+    ESP8266WebServer* server;
+    void put(char c);
+    void putP(PGM_P s);
+    void escaped(const char* s,boolean progmem);
+    void key(PGM_P k);
+  public:
+    JsonWriter(char* b,size_t s,ESP8266WebServer* srv=NULL);
+    void beginObject(PGM_P k=NULL);
+    void endObject();
+    void beginArray(PGM_P k=NULL);
+    void endArray();
+    void name(const char* k);  // key from RAM, the value follows with k=NULL
+    void add(PGM_P k,const char* value);
+    void add(PGM_P k,long value);
+    void addP(PGM_P k,PGM_P value);
+    void addBool(PGM_P k,boolean value);   // "true"/"false" as a string, the pages expect that
+    // string put together from more parts
+    void beginString(PGM_P k=NULL);
+    void text(const char* s);
+    void textP(PGM_P s);
+    void number(long value);
+    void endString();
+
+    const char* c_str();
+    size_t length();
+    boolean overflowed();
+    void flush();   // sends what is in the buffer (server only)
+    void finish();  // sends the rest and ends the chunked response (server only)
+};
+
+void beginJsonResponse(ESP8266WebServer& srv);
+
+#endif
+#endif
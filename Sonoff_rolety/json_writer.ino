@@ -0,0 +1,166 @@
+#ifdef _WEB_
+#include "json_writer.h"
+
+JsonWriter::JsonWriter(char* b,size_t s,ESP8266WebServer* srv) {
+  this->buf=b;
+  this->size=s;
+  this->len=0;
+  this->comma=false;
+  this->overflow=false;
+  this->server=srv;
+  this->buf[0]=0;
+}
+
+void JsonWriter::put(char c) {
+  if (this->len+1>=this->size) {
+    if (this->server==NULL) {
+      this->overflow=true;
+      return;
+    }
+    this->flush();
+  }
+  this->buf[this->len++]=c;
+  this->buf[this->len]=0;
+}
+
+void JsonWriter::putP(PGM_P s) {
+  char c;
+  while ((c=pgm_read_byte(s++))!=0) this->put(c);
+}
+
+void JsonWriter::escaped(const char* s,boolean progmem) {
+  char c;
+  while ((c=progmem?pgm_read_byte(s):*s)!=0) {
+    s++;
+    if (c=='"' || c=='\\') {
+      this->put('\\');
+      this->put(c);
+    } else if ((uint8_t)c<0x20) {
+      char u[7];
+      snprintf(u,sizeof(u),"\\u%04x",c);
+      for (int i=0; u[i]; i++) this->put(u[i]);
+    } else {
+      this->put(c);
+    }
+  }
+}
+
+void JsonWriter::key(PGM_P k) {
+  if (this->comma) this->put(',');
+  this->comma=true;
+  if (k!=NULL) {
+    this->put('"');
+    this->putP(k);
+    this->put('"');
+    this->put(':');
+  }
+}
+
+void JsonWriter::beginObject(PGM_P k) {
+  this->key(k);
+  this->put('{');
+  this->comma=false;
+}
+
+void JsonWriter::endObject() {
+  this->put('}');
+  this->comma=true;
+}
+
+void JsonWriter::beginArray(PGM_P k) {
+  this->key(k);
+  this->put('[');
+  this->comma=false;
+}
+
+void JsonWriter::endArray() {
+  this->put(']');
+  this->comma=true;
+}
+
+void JsonWriter::name(const char* k) {
+  this->key(NULL);
+  this->put('"');
+  this->text(k);
+  this->put('"');
+  this->put(':');
+  this->comma=false;
+}
+
+void JsonWriter::add(PGM_P k,const char* value) {
+  this->beginString(k);
+  this->text(value);
+  this->endString();
+}
+
+void JsonWriter::add(PGM_P k,long value) {
+  this->key(k);
+  char n[12];
+  ltoa(value,n,10);
+  for (int i=0; n[i]; i++) this->put(n[i]);
+}
+
+void JsonWriter::addP(PGM_P k,PGM_P value) {
+  this->beginString(k);
+  this->textP(value);
+  this->endString();
+}
+
+void JsonWriter::addBool(PGM_P k,boolean value) {
+  this->addP(k,value?PSTR("true"):PSTR("false"));
+}
+
+void JsonWriter::beginString(PGM_P k) {
+  this->key(k);
+  this->put('"');
+}
+
+void JsonWriter::text(const char* s) {
+  this->escaped(s,false);
+}
+
+void JsonWriter::textP(PGM_P s) {
+  this->escaped(s,true);
+}
+
+void JsonWriter::number(long value) {
+  char n[12];
+  ltoa(value,n,10);
+  for (int i=0; n[i]; i++) this->put(n[i]);
+}
+
+void JsonWriter::endString() {
+  this->put('"');
+}
+
+const char* JsonWriter::c_str() {
+  return this->buf;
+}
+
+size_t JsonWriter::length() {
+  return this->len;
+}
+
+boolean JsonWriter::overflowed() {
+  return this->overflow;
+}
+
+void JsonWriter::flush() {
+  if (this->server!=NULL && this->len>0) {
+    this->server->sendContent(this->buf,this->len);
+    this->len=0;
+    this->buf[0]=0;
+  }
+}
+
+void JsonWriter::finish() {
+  this->flush();
+  if (this->server!=NULL) this->server->sendContent(this->buf,0);  // empty chunk ends the response
+}
+
+// Headers of a chunked response - the JSON follows in JsonWriter chunks
+void beginJsonResponse(ESP8266WebServer& srv) {
+  srv.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  srv.send(200,"text/plane","");  // headers only, empty content is not sent
+}
+#endif
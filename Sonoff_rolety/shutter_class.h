@@ -53,6 +53,11 @@ class Shutter {
     String Name;
     boolean force_update;
     movement_type movement;
+    int published_position; // last state sent to MQTT
+    int published_tilt;
+    movement_type published_movement;
+    boolean Changed_since_publish();
+    void Mark_published();
     void Start_up();
     void Start_down();
     void Calibrate();
@@ -49,6 +49,9 @@ Shutter::Shutter() {
   
   this->movement=stopped;
   this->force_update=false;
+  this->published_position=-1;
+  this->published_tilt=-1;
+  this->published_movement=stopped;
   this->calibrating=false;
   this->semafor=false;
 }
@@ -70,6 +73,19 @@ void Shutter::setTilt(int tlt) {
   this->Tilt=tlt;
 }
 
+/************************************************
+ *  C H A N G E   S I N C E   L A S T   M Q T T
+ ************************************************/
+boolean Shutter::Changed_since_publish() {
+  return (abs(this->Position-this->published_position)>=publish_deadband_position || abs(this->getTilt()-this->published_tilt)>=publish_deadband_tilt);
+}
+
+void Shutter::Mark_published() {
+  this->published_position=this->Position;
+  this->published_tilt=this->getTilt();
+  this->published_movement=this->movement;
+}
+
 /***************
  *  G O   U P
  ***************/
@@ -3,89 +3,281 @@
 #include "shutter_class.h"
 #include "config.h"
 
+// Compressed page straight from flash, the browser revalidates with If-None-Match and gets 304 if nothing changed
+void sendPage(const uint8_t* page,size_t len,const char* etag) {
+  server.sendHeader(F("ETag"),etag);
+  server.sendHeader(F("Cache-Control"),F("no-cache"));
+  if (server.header(F("If-None-Match"))==etag) {
+    server.send(304);
+    return;
+  }
+  server.sendHeader(F("Content-Encoding"),F("gzip"));
+  server.send_P(200,PSTR("text/html"),(PGM_P)page,len);
+}
+
 void handleRootPath() {            //Handler for the rooth path
-   
-  String html = MAIN_page;
-  server.send(200, "text/html", html);
-  
+  sendPage(MAIN_page_gz,sizeof(MAIN_page_gz),MAIN_page_etag);
 }
 void handleConfigurePath() {            //Handler for the rooth path
-   
-  String html = CONFIGURE_page;
-  server.send(200, "text/html", html);
-  
+  sendPage(CONFIGURE_page_gz,sizeof(CONFIGURE_page_gz),CONFIGURE_page_etag);
 }
 
-void readMain() {
-  String mqttResults[10] = { F("-4: server didn't respond within the keepalive time"), F("-3: network connection was broken"), F("-2: network connection failed"), F("-1: client is disconnected cleanly"), F("0: client is connected"), F("1: server doesn't support the requested version of MQTT"), F("2: server rejected the client identifier"), F("3: server was unable to accept the connection"), F("4: username/password were rejected"), F("5: client was not authorized to connect") };
-  char buf1[25];
-  char buf2[25];
-  
-  DynamicJsonDocument root(700);   // normal 464
+// Configuration as the configure page edits it, in the static scratch copy
+configuration* editConfig() {
+  copyConfig(&cfg,&web_cfg);
+  if (web_defaults) defaultConfig(&web_cfg);
+  return &web_cfg;
+}
 
-  JsonArray keys = root.createNestedArray("keys");
+PGM_P mqttResult(int state) {
+  switch (state) {
+    case -6: return PSTR("-6: server refused a subscription");
+    case -5: return PSTR("-5: connecting");
+    case -4: return PSTR("-4: server didn't respond within the keepalive time");
+    case -3: return PSTR("-3: network connection was broken");
+    case -2: return PSTR("-2: network connection failed");
+    case -1: return PSTR("-1: client is disconnected cleanly");
+    case 0: return PSTR("0: client is connected");
+    case 1: return PSTR("1: server doesn't support the requested version of MQTT");
+    case 2: return PSTR("2: server rejected the client identifier");
+    case 3: return PSTR("3: server was unable to accept the connection");
+    case 4: return PSTR("4: username/password were rejected");
+    case 5: return PSTR("5: client was not authorized to connect");
+  }
+  return PSTR("unknown");
+}
 
-  keys.add(r1.btnUp.pressed?"Pressed":String(r1.btnUp.counter));
-  keys.add(r1.btnDown.pressed?"Pressed":String(r1.btnDown.counter));
-  keys.add(r2.btnUp.pressed?"Pressed":String(r2.btnUp.counter));
-  keys.add(r2.btnDown.pressed?"Pressed":String(r2.btnDown.counter));
+// Fast changing part of the main page - buttons and shutters
+void mainState(JsonWriter& w) {
+  w.beginArray(PSTR("keys"));
+  Button* keys[4]={&r1.btnUp,&r1.btnDown,&r2.btnUp,&r2.btnDown};
+  for (int i=0; i<4; i++) {
+    if (keys[i]->pressed) {
+      w.addP(NULL,PSTR("Pressed"));
+    } else {
+      w.beginString();
+      w.number(keys[i]->counter);
+      w.endString();
+    }
+  }
+  w.endArray();
 
-  JsonArray movement = root.createNestedArray("movement");
-  movement.add(r1.Movement());
-  movement.add(r2.Movement());
+  w.beginArray(PSTR("movement"));
+  w.add(NULL,r1.Movement());
+  w.add(NULL,r2.Movement());
+  w.endArray();
 
-  JsonArray position = root.createNestedArray("position");
-  position.add(r1.getPosition());
-  position.add(r2.getPosition());
-  //position.add(map(r1.getPosition(),0,100,100,0));
-  //position.add(map(r2.getPosition(),0,100,100,0));
+  w.beginArray(PSTR("position"));
+  w.add(NULL,(long)r1.getPosition());
+  w.add(NULL,(long)r2.getPosition());
+  w.endArray();
 
-  JsonArray tilt= root.createNestedArray("tilt");
-  tilt.add(r1.getTilt());
-  tilt.add(r2.getTilt());
-  
-  root["device"]=String(cfg.host_name);
-  root["two_covers"]=cfg.two_covers?"true":"false";
-  root["tilting"]=cfg.tilt?"true":"false";
-  root["wifi"]=String(WiFi.SSID());  
+  w.beginArray(PSTR("tilt"));
+  w.add(NULL,(long)r1.getTilt());
+  w.add(NULL,(long)r2.getTilt());
+  w.endArray();
+}
+
+// Device and connectivity part of the main page
+void mainStatus(JsonWriter& w) {
+  char buf[25];
+  struct station_config wifi;
+
+  w.add(PSTR("device"),cfg.host_name);
+  w.addBool(PSTR("two_covers"),cfg.two_covers);
+  w.addBool(PSTR("tilting"),cfg.tilt);
+  wifi_station_get_config(&wifi);   // WiFi.SSID() would make a String
+  memcpy(buf,wifi.ssid,min(sizeof(buf)-1,sizeof(wifi.ssid)));
+  buf[min(sizeof(buf)-1,sizeof(wifi.ssid))]=0;
+  w.add(PSTR("wifi"),buf);
+
+  w.beginString(PSTR("mqtt"));
+  w.textP(mqttResult(mqqtClient.state()));
   if (r1.semafor && r2.semafor) {
-    root["mqtt"]= mqttResults[mqqtClient.state()+4]+"(S1,S2)";
+    w.textP(PSTR("(S1,S2)"));
   } else if (r1.semafor) {
-    root["mqtt"]= mqttResults[mqqtClient.state()+4]+"(S1)";
+    w.textP(PSTR("(S1)"));
   } else if (r2.semafor) {
-    root["mqtt"]= mqttResults[mqqtClient.state()+4]+"(S2)";
+    w.textP(PSTR("(S2)"));
+  }
+  if (mqqtClient.offlinePending()>0 || mqqtClient.offlineDropped()>0) {
+    w.textP(PSTR(" | offline queue: "));
+    w.number(mqqtClient.offlinePending());
+    w.textP(PSTR(" waiting, "));
+    w.number(mqqtClient.offlineCoalesced());
+    w.textP(PSTR(" replaced, "));
+    w.number(mqqtClient.offlineDropped());
+    w.textP(PSTR(" dropped"));
+  }
+  if (mqqtClient.rxDroppedCount()>0) {
+    w.textP(PSTR(" | too long received: "));
+    w.number(mqqtClient.rxDroppedCount());
+  }
+  if (mqqtClient.subscribeRefused()>0) {
+    w.textP(PSTR(" | subscribe refused: "));
+    w.number(mqqtClient.subscribeRefused());
+  }
+  if (mqttConnectTime>0) {
+    w.textP(PSTR(" | connect: "));
+    w.number(mqttConnectTime);
+    w.textP(PSTR(" ms (blocking "));
+    w.number(mqttConnectBlocking);
+    w.textP(PSTR(" ms)"));
+  }
+  w.endString();
+
+  w.beginString(PSTR("disconnect"));
+  if (lastWiFiDisconnect==0) {
+    w.textP(PSTR("N/A"));
   } else {
-    root["mqtt"]= mqttResults[mqqtClient.state()+4];
+    timeDiff(buf,sizeof(buf),lastWiFiDisconnect);
+    w.text(buf);
+    w.textP(PSTR(" ago"));
   }
-  timeDiff(buf1,25,lastWiFiDisconnect);
-  timeDiff(buf2,25,lastMQTTDisconnect);
-  root["disconnect"]=((lastWiFiDisconnect==0)?"N/A":(String(buf1)+" ago"))+","+((lastMQTTDisconnect==0)?"N/A":(String(buf2)+" ago"));
-  timeDiff(buf1,25,0);
-  root["crc"]=crcStatus + " ("+String(buf1)+" ago)";
-  root["mem"]="program: "+String(ESP.getFreeSketchSpace()/1024)+" kB | heap: "+String(ESP.getFreeHeap()/1024)+" kB";
-  if(lastCommand=="")
-    root["mqttmsg"]= "N/A";
-  else
-    timeDiff(buf1,25,lastCallback);
-    root["mqttmsg"]= lastCommand + " ("+String(buf1)+" ago)";
-  root["strength"]=String(WifiGetRssiAsQuality(WiFi.RSSI()));
-  root["ip"]=WiFi.localIP().toString();
-  
-  if(lastUpdate==0) {
-    root["update"]="N/A";
+  w.textP(PSTR(","));
+  if (lastMQTTDisconnect==0) {
+    w.textP(PSTR("N/A"));
   } else {
-    timeDiff(buf1,25,lastUpdate);
-    root["update"]=String(buf1);
+    timeDiff(buf,sizeof(buf),lastMQTTDisconnect);
+    w.text(buf);
+    w.textP(PSTR(" ago"));
+  }
+  w.endString();
+
+  w.beginString(PSTR("crc"));
+  w.text(crcStatus.c_str());
+  timeDiff(buf,sizeof(buf),0);
+  w.textP(PSTR(" ("));
+  w.text(buf);
+  w.textP(PSTR(" ago)"));
+  w.endString();
+
+  w.beginString(PSTR("mem"));
+  w.textP(PSTR("program: "));
+  w.number(ESP.getFreeSketchSpace()/1024);
+  w.textP(PSTR(" kB | heap: "));
+  w.number(ESP.getFreeHeap()/1024);
+  w.textP(PSTR(" kB, fragmentation "));
+  w.number(ESP.getHeapFragmentation());
+  w.textP(PSTR(" %"));
+  w.endString();
+
+  w.beginString(PSTR("mqttmsg"));
+  if (lastCommand[0]==0) {
+    w.textP(PSTR("N/A"));
+  } else {
+    timeDiff(buf,sizeof(buf),lastCallback);
+    w.text(lastCommand);
+    w.textP(PSTR(" ("));
+    w.text(buf);
+    w.textP(PSTR(" ago)"));
+  }
+  w.endString();
+
+  w.beginString(PSTR("strength"));
+  w.number(WifiGetRssiAsQuality(WiFi.RSSI()));
+  w.endString();
+  IPAddress ip=WiFi.localIP();
+  snprintf(buf,sizeof(buf),"%u.%u.%u.%u",ip[0],ip[1],ip[2],ip[3]);
+  w.add(PSTR("ip"),buf);
+  w.addP(PSTR("build"),PSTR(__DATE__ " " __TIME__));
+
+  if (lastUpdate==0) {
+    w.addP(PSTR("update"),PSTR("N/A"));
+  } else {
+    timeDiff(buf,sizeof(buf),lastUpdate);
+    w.add(PSTR("update"),buf);
+  }
+}
+
+// Streamed as a chunked response from a buffer on the stack - no heap used
+void readMain() {
+  char buf[JSON_CHUNK];
+  JsonWriter w(buf,sizeof(buf),&server);
+
+  beginJsonResponse(server);
+  w.beginObject();
+  mainState(w);
+  mainStatus(w);
+  w.endObject();
+  w.finish();
+}
+
+/****************************************************************************
+* S E R V E R   S E N T   E V E N T S  -  L I V E   M A I N   P A G E
+* The state is pushed only when it changes, the status every update_interval_events
+****************************************************************************/
+#define EVENT_CLIENTS 4
+#define EVENT_SIZE 800
+
+WiFiClient eventClients[EVENT_CLIENTS];
+char lastStateEvent[200]="";
+unsigned long lastStatusEvent=0;
+
+// One write per event. A client that can't take it is dropped (the browser reconnects) - never block the shutters
+void sendEvent(WiFiClient& client,const char* event,size_t len) {
+  if (client.availableForWrite()<len) {
+    client.stop();
+    return;
   }
+  client.write((const uint8_t*)event,len);
+}
 
-  String out;
-  serializeJson(root,out);
-#ifdef DEBUG_updates
-  Serial.println(out);
-#endif  
-  server.send(200, "text/plane", out); //Send values to client ajax request
+// "event: <name>\ndata: {...}\n\n" into buf, returns the length (0 if it didn't fit)
+size_t formatEvent(char* buf,PGM_P name,void (*fill)(JsonWriter&)) {
+  size_t len=snprintf_P(buf,EVENT_SIZE,PSTR("event: %S\ndata: "),name);
+  JsonWriter w(buf+len,EVENT_SIZE-len-2);
+  w.beginObject();
+  fill(w);
+  w.endObject();
+  if (w.overflowed()) return 0;
+  len+=w.length();
+  buf[len++]='\n';
+  buf[len++]='\n';
+  return len;
 }
 
+void handleEvents() {
+  char buf[EVENT_SIZE];
+  size_t len;
+  int i;
+  for (i=0; i<EVENT_CLIENTS && eventClients[i].connected(); i++);
+  if (i==EVENT_CLIENTS) {
+    server.send(503, "text/plain", "Too many clients"); // the page falls back to polling
+    return;
+  }
+  eventClients[i]=server.client();
+  eventClients[i].print(F("HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\nConnection: keep-alive\r\n\r\n"));
+  
+  if ((len=formatEvent(buf,PSTR("state"),mainState))) sendEvent(eventClients[i],buf,len);
+  if ((len=formatEvent(buf,PSTR("status"),mainStatus))) sendEvent(eventClients[i],buf,len);
+}
+
+void broadcastEvent(const char* event,size_t len) {
+  for (int i=0; i<EVENT_CLIENTS; i++) {
+    if (eventClients[i].connected())
+      sendEvent(eventClients[i],event,len);
+  }
+}
+
+void pushEvents() {
+  char buf[EVENT_SIZE];
+  size_t len;
+  int i;
+  unsigned long now=millis();
+  for (i=0; i<EVENT_CLIENTS && !eventClients[i].connected(); i++);
+  if (i==EVENT_CLIENTS) return; // nobody listening
+
+  len=formatEvent(buf,PSTR("state"),mainState);
+  if (len>0 && len<sizeof(lastStateEvent) && strcmp(buf,lastStateEvent)!=0) {
+    strcpy(lastStateEvent,buf);
+    broadcastEvent(buf,len);
+  }
+  if (lastStatusEvent>now || now-lastStatusEvent>update_interval_events) {
+    lastStatusEvent=now;
+    if ((len=formatEvent(buf,PSTR("status"),mainStatus))) broadcastEvent(buf,len);
+  }
+}
 
 void pressButton() {
   String t_state = server.arg("button"); //Refer  request.open("GET", "pressButton?button="+button, true);
@@ -122,10 +314,10 @@ void pressButton() {
     Restart();
     break;
   case 77:
-    defaultConfig(&web_cfg);
+    web_defaults=true;
     break;
   case 88:
-    copyConfig(&web_cfg,&cfg);
+    if (web_defaults) defaultConfig(&cfg);
     saveConfig();    
     Restart();
     break;
@@ -133,137 +325,106 @@ void pressButton() {
  server.send(200, "text/plane", t_state); //Send web page
 }
 
-void updateField() {
- String t_field = server.arg("field");
- String t_value = server.arg("value");
- if (t_field.equals("host_name")) {
-    strncpy(web_cfg.host_name,t_value.c_str(),24);
- } else if (t_field.equals("vents")) {
-    web_cfg.vents = t_value.equals("true");
- } else if (t_field.equals("auto_hold_buttons")) {
-    web_cfg.auto_hold_buttons = t_value.equals("true");  
- } else if (t_field.equals("tilt")) {
-    web_cfg.tilt = t_value.equals("true");
- } else if (t_field.equals("two_covers")) {
-    web_cfg.two_covers = t_value.equals("true");
- } else if (t_field.equals("wifi_multi")) {
-    web_cfg.wifi_multi = t_value.equals("true");
- } else if (t_field.equals("wifi_ssid1")) {
-    strncpy(web_cfg.wifi_ssid1,t_value.c_str(),24);
- } else if (t_field.equals("wifi_password1")) {
-    strncpy(web_cfg.wifi_password1,t_value.c_str(),24);
- } else if (t_field.equals("wifi_ssid2")) {
-    strncpy(web_cfg.wifi_ssid2,t_value.c_str(),24);
- } else if (t_field.equals("wifi_password2")) {
-    strncpy(web_cfg.wifi_password2,t_value.c_str(),24);
- } else if (t_field.equals("mqtt_server")) {
-    strncpy(web_cfg.mqtt_server,t_value.c_str(),24);
- } else if (t_field.equals("mqtt_user")) {
-    strncpy(web_cfg.mqtt_user,t_value.c_str(),24);
- } else if (t_field.equals("mqtt_password")) {
-    strncpy(web_cfg.mqtt_password,t_value.c_str(),24);
- } else if (t_field.equals("publish_position1")) {
-    strncpy(web_cfg.publish_position1,t_value.c_str(),49);
- } else if (t_field.equals("publish_position2")) {
-    strncpy(web_cfg.publish_position2,t_value.c_str(),49);
- } else if (t_field.equals("publish_tilt1")) {
-    strncpy(web_cfg.publish_tilt1,t_value.c_str(),49);
- } else if (t_field.equals("publish_tilt2")) {
-    strncpy(web_cfg.publish_tilt2,t_value.c_str(),49);
- } else if (t_field.equals("subscribe_command1")) {
-    strncpy(web_cfg.subscribe_command1,t_value.c_str(),49);
- } else if (t_field.equals("subscribe_command2")) {
-    strncpy(web_cfg.subscribe_command2,t_value.c_str(),49);
- } else if (t_field.equals("subscribe_position1")) {
-    strncpy(web_cfg.subscribe_position1,t_value.c_str(),49);
- } else if (t_field.equals("subscribe_position2")) {
-    strncpy(web_cfg.subscribe_position2,t_value.c_str(),49);
- } else if (t_field.equals("subscribe_tilt1")) {
-    strncpy(web_cfg.subscribe_tilt1,t_value.c_str(),49);
- } else if (t_field.equals("subscribe_tilt2")) {
-    strncpy(web_cfg.subscribe_tilt2,t_value.c_str(),49);
- } else if (t_field.equals("subscribe_calibrate")) {
-    strncpy(web_cfg.subscribe_calibrate,t_value.c_str(),49);
- } else if (t_field.equals("subscribe_reboot")) {
-    strncpy(web_cfg.subscribe_reboot,t_value.c_str(),49);
- } else if (t_field.equals("subscribe_reset")) {
-    strncpy(web_cfg.subscribe_reset,t_value.c_str(),49);   
- } else if (t_field.equals("Shutter1_duration_down")) {
-    web_cfg.Shutter1_duration_down=constrain(t_value.toInt(),0,120000);
- } else if (t_field.equals("Shutter2_duration_down")) {
-    web_cfg.Shutter2_duration_down=constrain(t_value.toInt(),0,120000);
- } else if (t_field.equals("Shutter1_duration_up")) {
-    web_cfg.Shutter1_duration_up=constrain(t_value.toInt(),0,120000);
- } else if (t_field.equals("Shutter2_duration_up")) {
-    web_cfg.Shutter2_duration_up=constrain(t_value.toInt(),0,120000);
- } else if (t_field.equals("Shutter1_duration_vents_down")) {
-    web_cfg.Shutter1_duration_vents_down=constrain(t_value.toInt(),0,120000);
- } else if (t_field.equals("Shutter2_duration_vents_down")) {
-    web_cfg.Shutter2_duration_vents_down=constrain(t_value.toInt(),0,120000);
- } else if (t_field.equals("Shutter1_duration_tilt")) {
-    web_cfg.Shutter1_duration_tilt=constrain(t_value.toInt(),0,120000);
- } else if (t_field.equals("Shutter2_duration_tilt")) {
-    web_cfg.Shutter2_duration_tilt=constrain(t_value.toInt(),0,120000);
- } else if (t_field.equals("GPIO_KEY1")) {
-    web_cfg.GPIO_KEY1=constrain(t_value.toInt(),0,16);
- } else if (t_field.equals("GPIO_KEY2")) {
-    web_cfg.GPIO_KEY2=constrain(t_value.toInt(),0,16);
- } else if (t_field.equals("GPIO_KEY3")) {
-    web_cfg.GPIO_KEY3=constrain(t_value.toInt(),0,16);
- } else if (t_field.equals("GPIO_KEY4")) {
-    web_cfg.GPIO_KEY4=constrain(t_value.toInt(),0,16);
- }
- server.send(200, "text/plane", t_field); //Send web page
- server.send(200, "text/plane", t_value); //Send web page  
+// Checks one value from the configure page, with apply it is also written to c. Returns the error or NULL
+PGM_P configValue(configuration* c,const config_field* f,const char* value,boolean apply) {
+  byte* data=(byte*)c+f->offset;
+  uint32_t number;
+  char* end;
+
+  if (f->type==CFG_STRING) {
+    if (strlen(value)>=f->size) return PSTR("too long");
+    if (apply) {
+      memset(data,0,f->size);
+      strcpy((char*)data,value);
+    }
+    return NULL;
+  }
+  if (f->type==CFG_BOOL) {
+    if (strcmp_P(value,PSTR("true"))==0) number=1;
+    else if (strcmp_P(value,PSTR("false"))==0) number=0;
+    else return PSTR("not true/false");
+  } else {
+    if (!isdigit(value[0])) return PSTR("not a number");
+    number=strtoul(value,&end,10);
+    if (*end!=0) return PSTR("not a number");
+    if (number>f->max) return PSTR("too big");
+  }
+  if (apply) {
+    for (int i=0; i<f->size; i++) {
+      data[i]=(number>>(8*i)) & 0xff;
+    }
+  }
+  return NULL;
+}
+
+// The whole configure page in one form encoded POST, fields by id (readConfig gives them). Everything is checked first
+// and applied only if all fields are valid, then saved and the device restarted
+void handleSaveConfig() {
+  config_field f;
+  PGM_P error;
+  char msg[80];
+  char* end;
+
+  configuration* c=editConfig();
+  for (int apply=0; apply<2; apply++) {
+    for (int i=0; i<server.args(); i++) {
+      const String& name=server.argName(i);
+      if (name=="plain") continue;   // body as a whole
+      const char* label=name.c_str();
+      if (!isdigit(label[0]) || !configFieldById(strtoul(label,&end,10),&f) || *end!=0) {
+        error=PSTR("unknown field");
+      } else {
+        error=configValue(c,&f,server.arg(i).c_str(),apply);
+        label=f.name;
+      }
+      if (error!=NULL) {
+        snprintf_P(msg,sizeof(msg),PSTR("%s: %S"),label,error);
+        server.send(400, "text/plain", msg);
+        return;
+      }
+    }
+  }
+  copyConfig(c,&cfg);
+  saveConfig();
+  server.send(200, "text/plain", "OK");
+  server.client().stop();   // the answer has to leave before the restart
+  Restart();
 }
 
 void readConfig() {
-  
-  DynamicJsonDocument root(1500);   // normal 1279 (but can configure longer strings, so leave it)
-  root["host_name"] = web_cfg.host_name;
-  root["two_covers"] = web_cfg.two_covers?"true":"false";
-  root["tilt"] = web_cfg.tilt?"true":"false";
-  root["vents"] = web_cfg.vents?"true":"false";
-  root["auto_hold_buttons"] = web_cfg.auto_hold_buttons?"true":"false";
-  root["wifi_ssid1"] = web_cfg.wifi_ssid1;
-  root["wifi_password1"] = web_cfg.wifi_password1;
-  root["wifi_ssid2"] = web_cfg.wifi_ssid2;
-  root["wifi_password2"] = web_cfg.wifi_password2;
-  root["wifi_multi"] = web_cfg.wifi_multi?"true":"false";
-  root["mqtt_server"] = web_cfg.mqtt_server;
-  root["mqtt_user"] = web_cfg.mqtt_user;
-  root["mqtt_password"] = web_cfg.mqtt_password;
-  root["publish_position1"] = web_cfg.publish_position1;
-  root["publish_position2"] = web_cfg.publish_position2;
-  root["publish_tilt1"] = web_cfg.publish_tilt1;
-  root["publish_tilt2"] = web_cfg.publish_tilt2;
-  root["subscribe_command1"] = web_cfg.subscribe_command1;
-  root["subscribe_command2"] = web_cfg.subscribe_command2;
-  root["subscribe_position1"] = web_cfg.subscribe_position1;
-  root["subscribe_position2"] = web_cfg.subscribe_position2;
-  root["subscribe_tilt1"] = web_cfg.subscribe_tilt1;
-  root["subscribe_tilt2"] = web_cfg.subscribe_tilt2;
-  root["subscribe_calibrate"] = web_cfg.subscribe_calibrate;
-  root["subscribe_reboot"] = web_cfg.subscribe_reboot;
-  root["subscribe_reset"] = web_cfg.subscribe_reset;
-  root["Shutter1_duration_down"] = web_cfg.Shutter1_duration_down;
-  root["Shutter2_duration_down"] = web_cfg.Shutter2_duration_down;
-  root["Shutter1_duration_up"] = web_cfg.Shutter1_duration_up;
-  root["Shutter2_duration_up"] = web_cfg.Shutter2_duration_up;
-  root["Shutter1_duration_vents_down"] = web_cfg.Shutter1_duration_vents_down;
-  root["Shutter2_duration_vents_down"] = web_cfg.Shutter2_duration_vents_down;
-  root["Shutter1_duration_tilt"] = web_cfg.Shutter1_duration_tilt;
-  root["Shutter2_duration_tilt"] = web_cfg.Shutter2_duration_tilt;
-  root["GPIO_KEY1"] = web_cfg.GPIO_KEY1;
-  root["GPIO_KEY2"] = web_cfg.GPIO_KEY2;
-  root["GPIO_KEY3"] = web_cfg.GPIO_KEY3;
-  root["GPIO_KEY4"] = web_cfg.GPIO_KEY4;
-  
-  String out;
-  serializeJson(root,out);
-#ifdef DEBUG_updates
-  Serial.println(out);
-#endif  
-  server.send(200, "text/plane", out); //Send values to client ajax request
+  char buf[JSON_CHUNK];
+  JsonWriter w(buf,sizeof(buf),&server);
+  config_field f;
+  // Straight from cfg, only the defaults need the scratch copy
+  const configuration* c=web_defaults ? editConfig() : &cfg;
+
+  beginJsonResponse(server);
+  w.beginObject();
+  for (unsigned int i=0; configField(i,&f); i++) {
+    const byte* data=(const byte*)c+f.offset;
+    w.name(f.name);
+    if (f.type==CFG_STRING) {
+      w.add(NULL,(const char*)data);
+    } else {
+      uint32_t number=0;
+      for (int b=0; b<f.size; b++) {
+        number|=(uint32_t)data[b]<<(8*b);
+      }
+      if (f.type==CFG_BOOL) {
+        w.addBool(NULL,number!=0);
+      } else {
+        w.add(NULL,(long)number);
+      }
+    }
+  }
+  // The page posts the fields back by id
+  w.beginObject(PSTR("ids"));
+  for (unsigned int i=0; configField(i,&f); i++) {
+    w.name(f.name);
+    w.add(NULL,(long)f.id);
+  }
+  w.endObject();
+  w.endObject();
+  w.finish();
 }
 #endif
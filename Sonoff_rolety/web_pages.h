@@ -0,0 +1,396 @@
+// Generated by html/build_pages.py - do not edit, change the html files and run the script
+#ifndef WEB_PAGES_H
+#define WEB_PAGES_H
+
+// main.html: 9259 bytes, 2603 bytes compressed
+#define MAIN_page_etag "\"302ecbb6b65bbd6f\""
+const uint8_t MAIN_page_gz[] PROGMEM = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xdd,0x59,0xfd,0x72,0xdb,0xc6,
+  0x11,0xff,0x5f,0x4f,0x71,0x41,0x26,0x11,0x19,0x8b,0x20,0x09,0x52,0xb2,0x2b,0x7e,
+  0xa4,0x63,0xd9,0x6e,0xdc,0x91,0x63,0xd7,0x92,0x9b,0x76,0x32,0x99,0x0c,0x3e,0x96,
+  0xc4,0x95,0x00,0x0e,0xb9,0x3b,0x88,0x62,0x3d,0x7a,0x8d,0x3e,0x47,0xa7,0x7f,0xf7,
+  0xaf,0x3e,0x4a,0x9f,0xa4,0x7b,0x77,0x00,0x09,0x80,0x00,0x25,0x5b,0x99,0x4e,0xa7,
+  0xf6,0x98,0x26,0x76,0xf7,0x7e,0xb7,0xb7,0x5f,0xb7,0x0b,0x4e,0xbf,0x78,0xf1,0xf6,
+  0xe2,0xfa,0xcf,0xef,0x5e,0x92,0x50,0xc6,0xd1,0xfc,0x68,0x5a,0xfc,0x07,0x6e,0x80,
+  0xff,0xc5,0x20,0x5d,0xe2,0x87,0x2e,0x17,0x20,0x67,0xd6,0x87,0xeb,0x57,0xbd,0x67,
+  0x56,0x41,0x4e,0xdc,0x18,0x66,0xd6,0x0d,0x85,0x75,0xca,0xb8,0xb4,0x88,0xcf,0x12,
+  0x09,0x09,0x8a,0xad,0x69,0x20,0xc3,0x59,0x00,0x37,0xd4,0x87,0x9e,0x7e,0x38,0x21,
+  0x34,0xa1,0x92,0xba,0x51,0x4f,0xf8,0x6e,0x04,0xb3,0xa1,0x3d,0x50,0x30,0x42,0x6e,
+  0x22,0x98,0x1f,0xd9,0x72,0xcd,0x7a,0x3e,0xbb,0x01,0x2e,0xc8,0xc7,0x23,0x42,0x02,
+  0x2a,0xd2,0xc8,0xdd,0x9c,0x93,0x84,0x25,0x30,0x39,0xba,0x43,0x01,0x1a,0xc9,0x16,
+  0x16,0x87,0x98,0x49,0xf8,0x59,0x6d,0xce,0x59,0x54,0x11,0x5a,0x72,0x1a,0x4c,0xf0,
+  0x59,0xab,0x70,0x4e,0xc6,0x03,0x88,0xd5,0xa3,0x22,0xf7,0x24,0xc4,0x28,0x23,0x01,
+  0xf7,0x8d,0xb2,0x38,0x11,0xe7,0x64,0xb8,0xe0,0xe6,0xdf,0x20,0xbd,0x2d,0x1e,0xf6,
+  0xc5,0x39,0x5b,0xa3,0x2c,0x21,0x8e,0x7d,0x0a,0x71,0xfe,0x39,0x52,0x9f,0xfb,0xa2,
+  0x2e,0x07,0x17,0x65,0x91,0x4e,0x88,0x15,0x0e,0x49,0xe8,0x10,0x9b,0x84,0x23,0x12,
+  0x8e,0x2d,0x43,0x5b,0x0d,0xc9,0x4a,0xd1,0x56,0x23,0xb2,0x2a,0x68,0xde,0x90,0x78,
+  0x8a,0xe6,0x8d,0x88,0x37,0xb6,0xf4,0x09,0x85,0x74,0x65,0x26,0x0e,0x9d,0xcc,0x39,
+  0x7c,0xb2,0x33,0x7b,0x84,0x5a,0x16,0xe7,0x3b,0x4d,0x6f,0xdb,0x8e,0x55,0x3e,0x54,
+  0xe9,0x53,0x6b,0xe1,0xb3,0x38,0x76,0x93,0xa0,0x59,0x8f,0x36,0x93,0x9e,0x69,0x5b,
+  0xd6,0x3f,0x15,0xde,0x6f,0x63,0x08,0xa8,0x4b,0x58,0x12,0x6d,0x88,0xf0,0x39,0x40,
+  0x42,0x10,0x9d,0x74,0x62,0xf7,0xb6,0x97,0x9f,0xea,0xe9,0x00,0x65,0xbb,0x7a,0xbf,
+  0x26,0x2f,0xef,0x6b,0xb1,0x67,0x8f,0xfb,0x7c,0xdd,0x24,0xd3,0xea,0x60,0x13,0x18,
+  0x8d,0x7e,0x3f,0xe4,0xf9,0xc2,0xf7,0x56,0xf1,0xa4,0xbd,0xbe,0x7d,0xd2,0xfe,0xde,
+  0x3e,0xd9,0xc4,0xde,0x7e,0x2f,0x45,0x8a,0x5a,0xb5,0x8b,0x11,0xb5,0xca,0x44,0x87,
+  0xfa,0x8e,0xa4,0x3b,0x65,0xa1,0x52,0x94,0x3c,0xc6,0x32,0x95,0x58,0x69,0xb7,0x4f,
+  0x6b,0xa4,0xe4,0xda,0x54,0xa2,0xa5,0x49,0x9f,0xfb,0x1d,0x73,0x87,0x51,0xa2,0x8a,
+  0x91,0x86,0xf0,0xd8,0x6d,0x4f,0xd0,0xbf,0xd2,0x64,0x79,0x8e,0xdf,0x79,0x00,0xbc,
+  0x87,0x24,0x15,0x48,0xdf,0x9c,0x90,0x6f,0xce,0x3d,0x58,0x30,0x0e,0xea,0x9b,0xbb,
+  0x90,0xc0,0xf7,0x96,0xd0,0x24,0x04,0x4e,0xa5,0x92,0xf7,0x58,0xb0,0xd1,0xfc,0xd4,
+  0x0d,0x02,0xcd,0x74,0x54,0x48,0x2a,0x3b,0x7a,0xae,0xbf,0x5a,0x72,0x96,0x25,0x81,
+  0x52,0x88,0xf1,0x73,0xf2,0xa5,0x33,0x52,0x7f,0x95,0x3a,0x0b,0x0c,0xbd,0xde,0xc2,
+  0x8d,0x69,0x84,0xd5,0xe7,0x8f,0xc0,0x03,0x37,0x71,0x4f,0x88,0x70,0x13,0xd1,0x13,
+  0x88,0xbd,0xd0,0x08,0x5a,0x08,0x37,0x05,0x3c,0xc9,0x60,0xf0,0x95,0xa6,0xe5,0x50,
+  0xeb,0x90,0x4a,0x5d,0xb1,0x68,0x92,0x66,0xf2,0x84,0x44,0xae,0x07,0xd1,0x09,0x5a,
+  0xe6,0xa6,0x5a,0xd8,0x16,0x11,0xe8,0xfc,0x74,0x23,0xba,0x4c,0x7a,0xb8,0x26,0x46,
+  0xb3,0xf8,0x58,0x57,0x41,0x5b,0xe5,0x2f,0x99,0x90,0x74,0xb1,0xe9,0xe5,0xc5,0xb6,
+  0xcc,0x0a,0x81,0x2e,0x43,0x79,0xae,0x37,0xde,0xd5,0x86,0xe2,0xd1,0x58,0x0d,0x9f,
+  0x31,0x88,0x05,0x8b,0x68,0x80,0x2e,0x80,0xcd,0xa4,0xa6,0x74,0x9e,0xec,0x01,0x60,
+  0x4e,0xd2,0x54,0x52,0x96,0x90,0x8f,0xc6,0x57,0xc6,0x45,0x28,0xd2,0x77,0x26,0x44,
+  0x55,0xa5,0x61,0x9d,0xe3,0xf4,0x47,0x86,0xe3,0xd4,0x39,0xa3,0xfe,0x58,0x73,0xc2,
+  0xed,0x1a,0x95,0x21,0xe7,0x24,0x1c,0x1a,0xb2,0x53,0x23,0x9b,0x1d,0x30,0x01,0xaa,
+  0x64,0x03,0x1f,0x8e,0x6b,0x64,0x83,0xbd,0xaa,0x61,0xaf,0x0c,0xf6,0xaa,0x86,0xbd,
+  0x72,0x0e,0x92,0x6b,0x5b,0xae,0xcc,0x96,0xab,0xda,0x96,0x2b,0xb3,0xa5,0x57,0xdb,
+  0xd2,0x33,0x5b,0x7a,0x35,0x6c,0xcf,0x60,0x7b,0x35,0x6c,0xcf,0x60,0x7b,0x35,0x6c,
+  0x4f,0x63,0xa7,0x3a,0x28,0x4a,0x9e,0x19,0xd8,0xcf,0x9e,0xe6,0xa5,0x38,0x1c,0x9e,
+  0x10,0x6d,0xb2,0x7a,0x54,0x5a,0xcf,0xdd,0x30,0x11,0x7e,0x88,0xd1,0x28,0xc9,0x05,
+  0x4b,0x02,0x48,0x04,0x04,0x56,0x2d,0x4a,0x15,0x80,0x59,0x5c,0x04,0xf9,0x70,0xe1,
+  0x3a,0xe0,0xd7,0x42,0xc1,0xc1,0xcd,0xb4,0xb0,0x53,0x16,0x5e,0x85,0xee,0x8a,0x2a,
+  0xc9,0xd8,0xe5,0x4b,0x9a,0xf4,0x24,0x4b,0x51,0xf4,0x37,0x79,0x02,0xe5,0x44,0x8f,
+  0x49,0xc9,0xe2,0xf3,0xe2,0xa6,0x29,0xc7,0x97,0x7d,0x4a,0x14,0x2e,0xd1,0x97,0x3a,
+  0x4b,0xa9,0x8f,0xe0,0x9a,0xbf,0x36,0xc1,0x8b,0x61,0x1a,0x05,0xc6,0x2e,0x19,0x82,
+  0x24,0x26,0x93,0xf7,0xf3,0x12,0x55,0x1e,0x19,0x95,0xf3,0x6a,0xc0,0xdd,0x80,0x66,
+  0x42,0xd9,0x69,0xc4,0x4d,0x1d,0x92,0x1c,0x4f,0x4d,0x55,0x08,0xf7,0x82,0x8c,0xbb,
+  0xea,0x8b,0x62,0x8f,0x85,0x62,0xfa,0x19,0x17,0x0a,0x28,0x65,0xb4,0x48,0x1f,0xa3,
+  0xfc,0x56,0xeb,0x22,0x5f,0x06,0xe6,0xb1,0x9a,0xc5,0xa5,0xea,0xf1,0x54,0xdd,0x6a,
+  0xf9,0x1a,0x09,0xb7,0xb2,0xa7,0x13,0xb7,0x9c,0x97,0x9a,0x1a,0x80,0xcf,0x0a,0x25,
+  0x4c,0xef,0x52,0xca,0x79,0x9a,0x44,0x34,0x81,0x9e,0x17,0x31,0x7f,0x55,0xb7,0xd8,
+  0x99,0xb9,0x2f,0xf1,0x06,0xc4,0x16,0xac,0xc5,0x1a,0xc1,0x78,0x74,0x3a,0x3a,0xfd,
+  0xaf,0x58,0xe3,0x7f,0xc1,0x16,0x47,0xd3,0x7e,0xde,0x39,0x62,0x0b,0xa9,0xeb,0xd4,
+  0xfc,0x68,0x91,0x25,0xbe,0x2e,0x57,0x69,0x26,0xc2,0xe7,0x3a,0x76,0x3a,0x9e,0x69,
+  0x1e,0x6e,0x5c,0x4e,0x38,0xfc,0x92,0x81,0x90,0x64,0x46,0x12,0x58,0x93,0x3f,0xbd,
+  0xb9,0xfc,0x4e,0xca,0xf4,0xbd,0x21,0x76,0xba,0x6a,0x9f,0x5c,0xc2,0x66,0x09,0xa6,
+  0x61,0xb0,0x51,0xd7,0x29,0x60,0xe3,0x9b,0x2c,0x01,0x17,0x15,0xe8,0x9d,0xae,0x49,
+  0x06,0x42,0xe8,0x82,0x74,0x64,0x48,0x85,0xad,0xa5,0xaf,0x94,0x34,0x99,0xcd,0xc8,
+  0x98,0x7c,0xfd,0x35,0xd1,0xf4,0xfc,0x3e,0x46,0x9a,0x33,0x18,0x74,0xf3,0x7b,0x50,
+  0xdd,0x8d,0x77,0x95,0xdd,0x52,0x48,0x3a,0xd6,0xef,0x5e,0x5e,0x63,0x96,0x5a,0x29,
+  0xfa,0x58,0x18,0xdd,0xbf,0x35,0xe1,0x3f,0xb3,0x9e,0x78,0x27,0xe8,0xbb,0x0c,0x2a,
+  0x3a,0x0a,0x48,0x02,0xa5,0x35,0x9a,0xa2,0xdf,0x27,0x97,0xf4,0x06,0x48,0x96,0x06,
+  0xa8,0x82,0xd0,0xc7,0x87,0x80,0x78,0x1b,0xd4,0x02,0x88,0xe9,0xc1,0x4f,0xd0,0xb1,
+  0x11,0x5a,0x75,0x69,0xda,0x2d,0x54,0x5d,0xf1,0x3c,0x75,0x93,0xe3,0x5d,0xe9,0xbb,
+  0xc9,0xb1,0x24,0x01,0x23,0x54,0x92,0x0e,0xe3,0xa5,0x75,0x24,0x74,0x05,0x3a,0x88,
+  0x2c,0xb0,0x3d,0x23,0x22,0x62,0xb2,0xbb,0x33,0x33,0x1e,0x8f,0xcb,0x0f,0x66,0xd3,
+  0x8e,0x39,0x9e,0x32,0xc9,0x17,0x6b,0x9a,0x04,0x6c,0x6d,0xbf,0xbc,0x41,0x97,0x5f,
+  0xb1,0x8c,0xfb,0x50,0x9c,0x1d,0xc3,0xf7,0xb5,0x0a,0x83,0x1b,0x37,0xea,0x28,0xa3,
+  0xbd,0x71,0x69,0x72,0x42,0x4e,0xd1,0x38,0xa6,0x23,0xe0,0x20,0x33,0x9e,0x14,0x1d,
+  0x84,0x72,0x9a,0xd0,0xeb,0x73,0x9f,0x95,0x10,0x3b,0x16,0xa8,0x07,0x61,0xe9,0x95,
+  0x46,0xca,0xc6,0x18,0xd4,0x22,0x97,0x54,0xe0,0xc5,0x08,0xbc,0x63,0x69,0x17,0xa2,
+  0x5d,0xb7,0xce,0x53,0xaa,0x10,0x11,0xb2,0xb5,0x76,0x57,0xe7,0xf7,0x57,0x6f,0xbf,
+  0xb7,0x53,0x35,0xda,0x74,0xc0,0xc6,0x83,0xb8,0xdd,0x2e,0x56,0x9e,0xfb,0x31,0x33,
+  0xd1,0x0a,0x9a,0x89,0x07,0xa0,0x62,0xc4,0x73,0x8e,0x86,0xae,0x86,0xd5,0x36,0xaa,
+  0x72,0xa9,0x6a,0x5c,0x95,0x4e,0x6f,0x5f,0x5c,0xbe,0xbd,0x7a,0xf9,0xa2,0x9b,0xf7,
+  0x82,0x87,0xcd,0x7a,0xa7,0x83,0x64,0xeb,0x35,0x48,0x5c,0x2f,0x82,0x2b,0x95,0x3c,
+  0x9d,0x2c,0xa1,0x18,0x4d,0x3f,0x4b,0x2a,0x23,0xd8,0x25,0x8a,0x2f,0xc4,0x2c,0x60,
+  0x7e,0x16,0xe3,0x7e,0xb6,0xce,0xb2,0xab,0x10,0x40,0x8a,0x1f,0x07,0x3f,0x99,0x6c,
+  0xe4,0x1d,0x25,0x46,0x67,0x83,0x09,0xa1,0x53,0x94,0xb6,0xf1,0xdf,0xfb,0x2c,0x02,
+  0x61,0x47,0x90,0x2c,0x65,0x88,0xe4,0x27,0x4f,0x8a,0xf3,0xe8,0xd4,0x43,0x26,0x9e,
+  0xb5,0x2c,0xfa,0x23,0xfd,0x69,0x92,0xab,0xaf,0x4e,0x5c,0x63,0xa9,0xef,0xd7,0x58,
+  0x27,0x6c,0x9a,0xf8,0x51,0x86,0xad,0x48,0x55,0xd5,0x02,0xbb,0x1a,0x33,0xdb,0xec,
+  0x52,0xf5,0x09,0xf1,0x28,0x5e,0x7d,0x5c,0x2a,0xc8,0xca,0xea,0x27,0xc7,0xe4,0x63,
+  0x51,0x6a,0x74,0xe9,0xb9,0x3b,0x3e,0x19,0xe8,0x4c,0xda,0xda,0x08,0xd9,0xff,0x5f,
+  0x46,0x52,0x2b,0x03,0x88,0x40,0x82,0x36,0x07,0xed,0x4e,0x0e,0xda,0xaf,0x1c,0x2f,
+  0xa5,0xb8,0xc6,0xda,0x94,0x1a,0xd4,0xed,0xc9,0xf5,0x56,0x33,0xc5,0xb0,0x4d,0xc1,
+  0x98,0x94,0xb9,0x4b,0x90,0x2f,0x23,0x50,0x5f,0x9f,0x6f,0x5e,0x07,0x1d,0xcb,0x88,
+  0x58,0x5d,0xd4,0x18,0x13,0xe0,0xbb,0xeb,0x37,0x97,0x0f,0x5e,0x1a,0xff,0x22,0xe5,
+  0xfe,0x42,0x45,0xbd,0x77,0x59,0x2c,0x96,0xcd,0x2b,0x91,0x71,0x58,0x5d,0x2a,0xb0,
+  0xc7,0x4e,0xc0,0x6f,0xd8,0x79,0xc7,0x3b,0x08,0xe1,0x73,0x7f,0x7f,0x2d,0x12,0x0f,
+  0x2b,0x0d,0x71,0x83,0xc2,0xe6,0x12,0x6f,0x5d,0xb4,0xa6,0x0b,0xba,0xbf,0x4a,0x51,
+  0x0f,0x2e,0x13,0x92,0xeb,0x70,0xdc,0x5f,0x5a,0x70,0x9e,0x58,0xe4,0x2b,0xeb,0x20,
+  0x06,0x4d,0xf7,0x57,0xd3,0xf4,0xe0,0x12,0x73,0x57,0xed,0x2f,0x33,0xf4,0x83,0x4b,
+  0xbd,0x8c,0x46,0xc1,0xfe,0x4a,0x4d,0x9e,0x1c,0xe5,0x97,0x90,0x26,0xc9,0x35,0xfb,
+  0xd9,0xbc,0x53,0x9a,0xcd,0x2c,0x75,0x83,0x5a,0xdd,0x62,0x14,0xdd,0xa5,0xb7,0x55,
+  0x7a,0xf5,0x64,0x6e,0x13,0x88,0x04,0x68,0xb9,0x72,0xa9,0xac,0x8b,0x55,0xf6,0xa1,
+  0x91,0xc4,0xab,0xf5,0xf0,0x26,0x28,0x73,0x18,0x3e,0x17,0x68,0xca,0x3d,0x28,0xa5,
+  0x9e,0xaa,0x2c,0x74,0x36,0x9c,0xd0,0xe9,0x6c,0x3c,0x29,0x95,0x90,0x56,0x7b,0xad,
+  0x60,0x63,0x3d,0xa1,0x25,0x7b,0x61,0x91,0xd1,0x6a,0x23,0x03,0xcb,0x48,0x6f,0x98,
+  0xd7,0x18,0xba,0xe8,0x54,0xc9,0xb3,0xd9,0xf1,0x3b,0xd5,0x8e,0x40,0x70,0xbc,0xab,
+  0x25,0xf7,0x6e,0xa3,0x6b,0xa1,0xbd,0xeb,0x50,0x71,0xb7,0xe3,0x2f,0x17,0xcf,0x5c,
+  0xfc,0x73,0x3c,0x21,0xdb,0x3f,0x9f,0x06,0xa7,0xdb,0x4d,0x04,0xf2,0x22,0xc4,0x3d,
+  0x36,0xfa,0xde,0x69,0x4b,0x3e,0x52,0xb1,0xa7,0x67,0xe0,0x3f,0x3d,0x3b,0x9e,0x7c,
+  0x86,0x3a,0xa4,0xae,0x4f,0x7e,0xf5,0x94,0x1c,0xe4,0x94,0x1d,0x54,0xd8,0x37,0xc6,
+  0x18,0x52,0xc0,0x85,0x8d,0x05,0x0e,0x41,0xe9,0xc3,0x6c,0x5c,0x2c,0x7d,0xfc,0x79,
+  0x1a,0x90,0x9a,0x0f,0xf5,0x40,0x23,0xdf,0xaf,0x59,0x11,0x02,0x9f,0xab,0x59,0x83,
+  0xb5,0x1f,0x8a,0x52,0xaf,0xa4,0x65,0x07,0x4c,0x0e,0xe3,0xa4,0xcc,0x4c,0x4c,0x4d,
+  0x38,0x05,0x4f,0xe3,0x6c,0xab,0xe4,0x01,0x30,0x9d,0xe2,0x0d,0x40,0x8a,0x5e,0x80,
+  0xfc,0xeb,0xef,0xd6,0x64,0xef,0x0e,0x2e,0x9a,0xba,0xce,0xae,0xff,0xb8,0x0d,0x71,
+  0x7a,0x39,0x30,0xcb,0x68,0xfe,0xfd,0x93,0xcc,0xe7,0x0d,0x32,0xb5,0x24,0x36,0xd3,
+  0x95,0x48,0x67,0xa4,0xd4,0xf9,0xe6,0x80,0x22,0x65,0xd8,0x86,0xa9,0x36,0x65,0xdb,
+  0x73,0xd4,0x3b,0x8a,0x3a,0x1d,0xca,0xe4,0xed,0xb8,0x94,0x1f,0xa8,0x3c,0x2c,0x15,
+  0x66,0xb1,0x4a,0xf3,0x91,0x11,0xdb,0x4d,0x47,0x38,0x27,0xe6,0xe3,0xa1,0x9a,0x19,
+  0xf3,0x9f,0x34,0xf2,0x1f,0x38,0xf4,0x7b,0x40,0x9c,0x87,0x98,0x1b,0xcc,0xac,0xea,
+  0x34,0x33,0xb1,0xf2,0x1f,0x40,0x80,0xcf,0xa7,0xe1,0x90,0x50,0x94,0xc8,0xbb,0x97,
+  0x39,0xc2,0x0c,0xe7,0x06,0x0b,0xb9,0x08,0x1b,0x3a,0xf3,0x2b,0x48,0x70,0x7c,0x16,
+  0x48,0x75,0xd4,0x8f,0x1a,0x60,0xfc,0xe6,0x47,0x2e,0xb6,0x89,0x56,0xf5,0xcd,0xb5,
+  0x35,0x57,0x76,0x9b,0xaa,0xb7,0x7e,0x39,0x3f,0x1c,0x5a,0xf3,0xab,0x10,0xa7,0x3d,
+  0x1c,0xc5,0x86,0xe4,0xc3,0xbb,0x69,0x1f,0x99,0xf3,0xba,0x90,0x53,0x16,0x7a,0xf1,
+  0xf6,0x87,0xef,0x9b,0xc5,0x46,0xa4,0x74,0x51,0x6d,0x57,0x38,0xad,0xb0,0xe3,0x16,
+  0xf9,0xd6,0x1d,0x56,0x43,0x4b,0x9b,0x03,0x4b,0xe2,0x50,0x19,0xa3,0x49,0xc4,0xd9,
+  0x8a,0x38,0x6d,0x22,0x15,0x3d,0x0b,0xe9,0x51,0x9b,0xf4,0xb8,0x49,0x7a,0x6c,0x15,
+  0xfc,0xf2,0x11,0x1a,0x01,0x3c,0xa5,0x6a,0xfe,0x3e,0x49,0x6e,0x52,0x40,0x8a,0x7e,
+  0xd8,0x22,0x14,0x8f,0x2c,0x89,0x59,0x86,0x57,0x1e,0x5b,0xe3,0xe4,0x5d,0x7a,0x91,
+  0x30,0xec,0x6e,0x79,0x59,0x5a,0xe5,0x20,0x6b,0xfe,0xef,0xbf,0xfd,0x63,0xda,0x37,
+  0x18,0x2d,0x0a,0x38,0x8f,0x54,0xc0,0x69,0x57,0xc0,0xd1,0x0a,0xfc,0xf3,0x1e,0x05,
+  0xaa,0x81,0xf1,0x28,0x5d,0x46,0xed,0xba,0x8c,0x1e,0x64,0x8c,0xf1,0xaf,0xa7,0xcb,
+  0xb8,0x5d,0x97,0x71,0xb3,0x5d,0xb0,0x24,0x98,0xfc,0x2c,0x72,0xd7,0xc4,0xbc,0x49,
+  0x5e,0x2c,0x6a,0xf5,0xf4,0xcd,0x07,0xfe,0x39,0xa9,0xe7,0x6d,0xe9,0x15,0x79,0x4b,
+  0xd8,0x89,0x72,0x66,0x37,0x4b,0x38,0xcd,0xf9,0xd7,0x28,0x5c,0xd9,0xb0,0xb8,0xc6,
+  0xaa,0x92,0x2a,0x35,0x0a,0xce,0xd0,0x2a,0xeb,0xd1,0x2e,0xe7,0x58,0x2d,0xda,0xdc,
+  0xaf,0x44,0x71,0x07,0xee,0x83,0x17,0x9c,0xfb,0x94,0x28,0xe4,0x3e,0x5b,0x09,0xa2,
+  0xaf,0xd5,0xf9,0x35,0x7e,0xee,0xa3,0x2b,0x5e,0x59,0x83,0x5c,0xb8,0x59,0xb0,0xaa,
+  0x82,0xfa,0xbd,0xb9,0x41,0x8f,0x7a,0xf4,0x5c,0x98,0x29,0x90,0xde,0x50,0xb9,0xa9,
+  0x96,0x7f,0x8d,0x9f,0xce,0xa7,0x22,0x75,0xb7,0xb1,0xa4,0x5f,0x78,0xa3,0x9b,0xaf,
+  0x5e,0xbf,0x38,0x47,0x24,0xe4,0xcc,0x89,0x11,0x50,0x4a,0xe8,0x19,0x6e,0x9e,0xd3,
+  0xa7,0xfd,0xf4,0x10,0x02,0x5d,0x26,0x6e,0x44,0xcc,0x90,0x16,0xca,0x06,0xb0,0xed,
+  0x64,0xf7,0x30,0xc0,0xd7,0xef,0x88,0x1b,0x04,0xaa,0xdf,0x6f,0xc0,0xc2,0x09,0xaf,
+  0x82,0x52,0x37,0xc2,0x9b,0x3f,0x5c,0x5f,0x3f,0xfc,0xf0,0x3a,0x9f,0x1a,0x76,0xd1,
+  0x33,0xfe,0xc3,0xb4,0xbd,0x74,0x85,0xc4,0x9e,0xc3,0x07,0x7a,0x03,0x01,0x89,0x51,
+  0x6b,0x77,0x09,0x2d,0x90,0x6a,0xfe,0xff,0x04,0x54,0x33,0x82,0x36,0x60,0xe5,0x33,
+  0xeb,0x27,0x40,0x45,0x4c,0x08,0xc2,0x16,0xe4,0x07,0xfa,0x8a,0x9e,0x28,0x1b,0x35,
+  0xa0,0x96,0x5e,0x32,0x3c,0x0c,0xf9,0x39,0x63,0x92,0x5c,0xbc,0xbf,0x20,0x7e,0x08,
+  0xfe,0xaa,0x01,0x51,0xbd,0x73,0x78,0x18,0xd4,0x2b,0xf5,0x56,0x37,0xc6,0xee,0x84,
+  0x6f,0x9a,0x6c,0x07,0xf1,0x61,0xaf,0x5f,0xe4,0xbf,0xf0,0x36,0x77,0x3d,0xc5,0xef,
+  0xbf,0x96,0x56,0xe0,0x50,0x89,0xd7,0xbf,0x6b,0xa8,0x2a,0xee,0x47,0xd4,0x5f,0xcd,
+  0xac,0x88,0xf9,0xfa,0xa7,0x01,0x3b,0xe4,0xb0,0x98,0x1d,0xf7,0xd1,0x3e,0x0b,0xba,
+  0xcc,0x38,0x1c,0x63,0x5b,0x76,0x51,0x3c,0x6c,0xcb,0xfa,0x63,0xe1,0xb3,0x74,0xc9,
+  0xb1,0x95,0x53,0xe0,0x1f,0xcc,0xd7,0x4f,0x87,0x6e,0xba,0x7f,0x4e,0x4f,0xf1,0xfe,
+  0xb9,0x70,0x23,0xea,0x71,0x8c,0x9b,0x5f,0x07,0xf3,0xec,0x0c,0x31,0xdf,0x83,0x6e,
+  0x56,0x77,0x88,0x3b,0xc7,0x4c,0x3d,0x4e,0xfa,0xb8,0xc5,0xd1,0x74,0x81,0x61,0xa2,
+  0x9b,0xd7,0x33,0x13,0x8b,0x3e,0x0b,0x80,0x98,0x19,0xe0,0xbc,0xe4,0x64,0xf3,0x36,
+  0x65,0xe7,0x66,0x14,0x9f,0xf6,0xf3,0xb5,0xaa,0x63,0x56,0x3d,0xb2,0xda,0xc0,0xb4,
+  0xcc,0xff,0x01,0x01,0x65,0x86,0x2c,0x2b,0x24,0x00,0x00,
+};
+
+// configure.html: 18342 bytes, 3477 bytes compressed
+#define CONFIGURE_page_etag "\"11ea676adba88115\""
+const uint8_t CONFIGURE_page_gz[] PROGMEM = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xdd,0x5b,0x7b,0x77,0xdb,0xb6,
+  0x15,0xff,0xdf,0x9f,0x02,0x63,0xcf,0x1a,0xa9,0xb1,0x24,0x8b,0xf2,0x23,0xb5,0x25,
+  0x76,0x89,0x9b,0x36,0xd9,0xda,0xc6,0x8b,0xdc,0x6e,0x3d,0x39,0x3b,0x3e,0x14,0x09,
+  0x99,0x98,0xf9,0x2a,0x1f,0x76,0xbc,0x1c,0x7f,0xf7,0xdd,0x0b,0x80,0x24,0xf8,0x92,
+  0x28,0x59,0x4e,0xbb,0xa5,0xa7,0x26,0x09,0x5c,0xfc,0x70,0x5f,0xb8,0x00,0x2e,0xa0,
+  0xe9,0x9f,0xbe,0x7d,0x77,0x7e,0xf9,0xeb,0xc5,0x6b,0xe2,0x24,0x9e,0x6b,0xec,0x4d,
+  0xb3,0x07,0x35,0x6d,0x78,0x78,0x34,0x31,0x89,0xe5,0x98,0x51,0x4c,0x93,0x99,0xf6,
+  0xf3,0xe5,0x77,0x83,0x17,0x5a,0x56,0xec,0x9b,0x1e,0x9d,0x69,0xb7,0x8c,0xde,0x85,
+  0x41,0x94,0x68,0xc4,0x0a,0xfc,0x84,0xfa,0x40,0x76,0xc7,0xec,0xc4,0x99,0xd9,0xf4,
+  0x96,0x59,0x74,0xc0,0x3f,0xf6,0x09,0xf3,0x59,0xc2,0x4c,0x77,0x10,0x5b,0xa6,0x4b,
+  0x67,0xe3,0xe1,0x01,0xc2,0xc4,0xc9,0xbd,0x4b,0x8d,0xbd,0x61,0x72,0x17,0x0c,0xac,
+  0xe0,0x96,0x46,0x31,0xf9,0xb4,0x47,0x88,0xcd,0xe2,0xd0,0x35,0xef,0x4f,0x89,0x1f,
+  0xf8,0xf4,0x6c,0xef,0x01,0x08,0x98,0x9b,0x90,0x4f,0xa4,0xb1,0xee,0x16,0xfa,0x8c,
+  0xdb,0x2a,0xef,0xd8,0x92,0x5d,0x79,0xa9,0x9b,0xb0,0x36,0x0a,0xe4,0xda,0x64,0x3e,
+  0x8d,0x4a,0x5d,0x5f,0x47,0xcc,0x3e,0x83,0x6f,0x7c,0x0e,0x12,0xea,0x41,0x61,0x42,
+  0x81,0x47,0x37,0xf5,0xfc,0xf8,0x94,0x8c,0xa9,0x47,0xf4,0xa3,0xf0,0x23,0x19,0x1f,
+  0xc0,0xdb,0x31,0xfc,0x7f,0x52,0x3c,0xf3,0x76,0x66,0x9a,0x04,0x83,0x28,0xb8,0x83,
+  0x06,0xf8,0x8a,0xdd,0xb9,0xe6,0x82,0xba,0x43,0x9b,0xc6,0x56,0xc4,0xc2,0x84,0x05,
+  0xfe,0xbe,0x28,0x59,0xb2,0x28,0x4e,0xe4,0x7b,0x4c,0x81,0x27,0x7b,0x7f,0x68,0x39,
+  0xd4,0xba,0x59,0x04,0x1f,0x39,0x63,0xa6,0xcb,0xae,0xfd,0x41,0x4c,0xdd,0xe5,0x29,
+  0xb1,0x40,0x62,0x1a,0x09,0xee,0x55,0x1a,0xde,0xa9,0xe0,0xf1,0x94,0xe8,0xa3,0x09,
+  0xa7,0x50,0xfa,0xaa,0x13,0x4d,0x46,0x87,0x9c,0x48,0x74,0x4f,0x86,0xcb,0xd4,0x75,
+  0xeb,0x54,0x87,0xa3,0x63,0x4e,0x25,0x18,0x13,0x8a,0x2c,0x11,0x1c,0x8f,0x5e,0x70,
+  0x02,0x74,0x1a,0xa9,0xc8,0x0a,0x2f,0x83,0xb1,0x54,0xb6,0xe7,0x99,0xbe,0x1d,0x6f,
+  0xa4,0xeb,0xe3,0x03,0x54,0x74,0xf5,0x2f,0xe2,0x31,0x3f,0x4c,0x81,0x6d,0xd0,0x0a,
+  0xb5,0x12,0x8e,0xe9,0x50,0x76,0xed,0x24,0xd0,0xe3,0x50,0x47,0x43,0x48,0x85,0x97,
+  0xaa,0xc6,0x59,0xd5,0x5f,0x3c,0x6a,0x33,0x93,0x04,0xbe,0x7b,0x4f,0x40,0x47,0x94,
+  0xfa,0x04,0x78,0x23,0x3d,0xcf,0xfc,0x28,0xbc,0x16,0x24,0x3f,0x80,0x9e,0xfa,0xbc,
+  0x79,0xc5,0x51,0x5a,0xd9,0x45,0x06,0x75,0x1d,0xfe,0xbc,0x00,0x6f,0x40,0x3f,0x19,
+  0x2f,0x23,0x7c,0xa2,0x84,0x0f,0x88,0x93,0xeb,0xb8,0x49,0xcb,0x19,0x0d,0xda,0x63,
+  0x1d,0x91,0x6a,0x8e,0x0a,0xd9,0xd1,0xe8,0x24,0x27,0x2b,0xe9,0xbc,0x5d,0xcb,0xc8,
+  0xe5,0x32,0x12,0xad,0x56,0xe8,0x86,0xf9,0x85,0x6e,0xc6,0xa8,0x9b,0xaa,0xca,0x4e,
+  0x76,0xa1,0x32,0x5d,0xbc,0xfc,0x6f,0xe9,0x0c,0x23,0x27,0x6f,0x00,0xe3,0x71,0x10,
+  0xb3,0xff,0x30,0xff,0xfa,0x14,0xde,0x23,0x18,0x12,0x03,0x28,0x42,0x97,0xfb,0x6a,
+  0x9f,0x7c,0x75,0xba,0xa0,0xcb,0x20,0xa2,0xf8,0x66,0x2e,0x13,0xa9,0x1b,0xb5,0x09,
+  0xf3,0x1d,0x1a,0xb1,0x04,0xe9,0x17,0x81,0x7d,0xcf,0xeb,0x43,0xd3,0xb6,0x79,0xa5,
+  0x8e,0xae,0x8f,0xdc,0x2f,0x4c,0xeb,0xe6,0x3a,0x0a,0x52,0x9f,0x4b,0x10,0x44,0xa7,
+  0xe4,0x0b,0x7d,0x82,0xff,0x21,0x3b,0x4b,0x50,0xfc,0x60,0x69,0x7a,0xcc,0x85,0x50,
+  0xf7,0x0b,0x8d,0x6c,0xd3,0x37,0x61,0x9c,0x98,0x7e,0x0c,0x21,0x24,0x62,0x4b,0x8e,
+  0xc0,0x89,0xa0,0x53,0x0a,0x92,0x1c,0x1c,0xfc,0x99,0x97,0x49,0xa8,0x3b,0x87,0x25,
+  0x18,0x1e,0xc9,0x9e,0x33,0xde,0x27,0x8e,0x2e,0x14,0x56,0x42,0xd5,0x5e,0x99,0x8e,
+  0x1f,0x5b,0x0e,0xa0,0x25,0xe4,0x1c,0x94,0x4a,0xfd,0x98,0xda,0x5a,0xa5,0x17,0xd0,
+  0xca,0x58,0x34,0xce,0x98,0x1c,0x2f,0x4d,0x9d,0x5a,0x67,0xe5,0xfe,0x71,0x44,0x72,
+  0x62,0x5d,0x25,0xbe,0x71,0xcc,0x1b,0x86,0x94,0x9e,0x19,0x5d,0x83,0xe3,0x25,0x41,
+  0x08,0xa4,0x5f,0x4b,0x05,0xc8,0xc2,0x45,0x90,0x24,0x81,0x07,0xe6,0xc3,0x90,0x50,
+  0x16,0x6a,0x78,0x44,0x10,0x97,0xf0,0x19,0x24,0x08,0x99,0x05,0xe0,0xbc,0xfe,0x4e,
+  0x86,0x82,0x45,0xe0,0xda,0x67,0x60,0xbb,0xe1,0x22,0x05,0x10,0x11,0x1f,0x1b,0xf4,
+  0x0a,0x2c,0x4f,0x04,0xcb,0xd2,0x9a,0x91,0x69,0xb3,0x14,0x1d,0x77,0x38,0x89,0x84,
+  0x97,0x26,0x11,0x48,0xcd,0x30,0xc8,0x0e,0xec,0x34,0x32,0xf1,0x05,0xab,0x0f,0x63,
+  0xac,0xb4,0xd2,0x28,0x46,0xa0,0x30,0x60,0x22,0x70,0x67,0xcc,0xe7,0x5c,0x0b,0x5c,
+  0x68,0x71,0x56,0xb3,0x81,0x62,0xfb,0x13,0x8c,0x7d,0xb2,0x45,0x42,0x3f,0x26,0x03,
+  0x3e,0x29,0x14,0xf3,0x81,0x2c,0xb5,0xc1,0xc7,0x33,0x16,0xc4,0x34,0xa7,0xcc,0x7b,
+  0xcc,0x77,0x61,0x40,0x0e,0x16,0x6e,0x60,0xdd,0x54,0xf5,0x75,0x2c,0xa2,0xea,0x30,
+  0xa2,0x30,0xdb,0xb7,0xe8,0xc2,0x3e,0x9c,0x1c,0x4d,0x8e,0x76,0xaa,0x8b,0x92,0xf0,
+  0x15,0xc5,0xfc,0xde,0xba,0x98,0x8e,0xe4,0x1a,0x05,0x16,0x2b,0x7c,0x1a,0x35,0xf6,
+  0x96,0xa9,0x6f,0xf1,0xd9,0x34,0x4c,0x63,0xe7,0x15,0x77,0x9c,0xde,0x42,0x04,0xbc,
+  0x5b,0x33,0x22,0x11,0xfd,0x2d,0xa5,0x10,0x88,0x66,0xc4,0xa7,0x77,0xe4,0x9f,0x3f,
+  0xfe,0xf0,0x26,0x49,0xc2,0xf7,0xa2,0xb0,0xd7,0xc7,0x6e,0x24,0xc5,0x30,0xf0,0x23,
+  0x98,0x2f,0xef,0xe3,0x04,0x82,0x0a,0x2c,0xb1,0xfc,0x6b,0x0a,0x8d,0x32,0xf4,0x5e,
+  0x3f,0x0b,0x52,0x6c,0x49,0x7a,0x89,0xc3,0xe2,0x21,0xa7,0x9e,0x23,0x35,0x99,0xcd,
+  0xc8,0x21,0xf9,0xf2,0x4b,0xc2,0xcb,0x11,0x20,0x8d,0xb1,0x4c,0x3f,0x38,0xe8,0xcb,
+  0x90,0x85,0x61,0xec,0xa1,0xd4,0x5b,0x48,0xfd,0x9e,0xf6,0xfd,0xeb,0x4b,0x18,0xa2,
+  0x5a,0x08,0x26,0x8e,0x05,0xef,0xdf,0x08,0xdf,0x9f,0x69,0xcf,0x17,0xfb,0x60,0xba,
+  0x94,0x96,0x78,0x8c,0xa9,0x6f,0x0b,0xae,0xd9,0xb2,0xb7,0x98,0xcd,0x4e,0x4e,0xfa,
+  0x1c,0x1e,0x79,0x81,0x41,0xbf,0x64,0xd7,0x6a,0xed,0x8b,0xaf,0xb3,0xee,0x41,0xa5,
+  0x5c,0xeb,0x43,0x27,0xa2,0xcb,0xd9,0xb3,0xd1,0xb3,0x2c,0x48,0x16,0xea,0xa3,0xbe,
+  0xb9,0x70,0xe9,0x1c,0xd5,0xdb,0x4b,0x7d,0x06,0xfd,0x5d,0x25,0x2c,0x71,0x69,0xa1,
+  0x4a,0x2b,0x8e,0x67,0x76,0x60,0xa5,0x1e,0xd8,0x74,0xc8,0xed,0x30,0x77,0x28,0x4d,
+  0xe2,0x0f,0x07,0xff,0x12,0xe6,0x8a,0x7a,0x48,0xc6,0x66,0x07,0x67,0x84,0x4d,0x81,
+  0x7a,0x08,0xff,0xbf,0x4f,0x5d,0x1a,0x0f,0x5d,0xea,0x5f,0x27,0x0e,0x14,0x3f,0x7f,
+  0x9e,0xb1,0xc4,0x8d,0x03,0x95,0xa0,0x64,0x95,0xf4,0x03,0xe3,0x60,0x99,0xa6,0x2b,
+  0x55,0xf8,0x7e,0x09,0x8e,0x34,0x64,0xbe,0xe5,0xa6,0xb0,0x96,0x2a,0xb3,0x9a,0x61,
+  0x0b,0x95,0x24,0x69,0xe4,0x67,0x58,0x0f,0x72,0x2a,0x41,0x3c,0x06,0x91,0x31,0x4a,
+  0x10,0xb2,0xd4,0xfa,0xf9,0x33,0xf2,0x29,0xf3,0x45,0xee,0x9b,0x0f,0xcf,0xf6,0x0f,
+  0xfa,0xe8,0x75,0xb9,0x8e,0xa0,0xfa,0xff,0x4b,0x49,0xd8,0xd2,0x86,0xe5,0x5a,0x42,
+  0xb9,0x3a,0x58,0xff,0x6c,0xa5,0xfe,0x54,0x7f,0x59,0x32,0xea,0xda,0xe7,0x7c,0x9c,
+  0xd8,0x3d,0xfe,0xb1,0x7f,0x6b,0xba,0xa9,0x54,0x05,0xb2,0xc5,0x0b,0x67,0x33,0xcd,
+  0x82,0x88,0x95,0x68,0x59,0xb7,0x58,0xc3,0x09,0xa1,0x46,0xd7,0xfa,0x12,0xbf,0xa4,
+  0x59,0x4d,0xd9,0x81,0x68,0x92,0x25,0xea,0xc6,0x54,0xd2,0xaa,0x9e,0x5a,0x27,0x7d,
+  0x20,0x95,0xee,0x71,0xb3,0x52,0xef,0xbd,0xad,0x63,0x4e,0xbc,0xae,0xcb,0x9c,0xe8,
+  0xa1,0xd2,0x17,0xdf,0xfc,0x74,0xee,0x4c,0x52,0xaf,0xe9,0x4d,0xa1,0xaa,0x76,0x57,
+  0x6c,0xa7,0x3a,0xf7,0xa9,0x36,0x59,0xd3,0x71,0x95,0x94,0xdb,0x7f,0x34,0x22,0xdf,
+  0x61,0xef,0x84,0xc1,0x72,0xac,0xb7,0x8c,0x02,0x4f,0x09,0x3e,0x7d,0x32,0x80,0x18,
+  0x48,0x89,0xd8,0x6b,0x82,0x8b,0xe0,0x9a,0x0d,0x0b,0xc2,0x20,0x4e,0xa8,0x2d,0x7c,
+  0x26,0x26,0x8b,0x7b,0x2c,0xf4,0xf6,0xd0,0xbb,0x79,0xd1,0x5b,0x28,0x9c,0x91,0x4f,
+  0x10,0x20,0x11,0xff,0x25,0x2c,0x2e,0x25,0x25,0xf3,0x61,0xcd,0x4b,0xf3,0x20,0x5e,
+  0x42,0xe7,0x7b,0x2d,0x0e,0xef,0xc1,0x76,0xcc,0xc5,0x95,0xce,0x2d,0x8d,0xf9,0x02,
+  0x18,0xc2,0x69,0x62,0x46,0xb0,0x0d,0xed,0x05,0x11,0x14,0xc4,0x77,0xb8,0x95,0x85,
+  0x49,0xcb,0x72,0x04,0x30,0x61,0xf0,0x19,0x05,0xfe,0x75,0xbf,0xf0,0x67,0x6c,0x9d,
+  0x85,0xd0,0x7c,0x34,0x4b,0x36,0x66,0x24,0x1f,0xd2,0xc0,0x48,0x74,0x3f,0xe7,0x3b,
+  0x9c,0x20,0x02,0x4e,0x7b,0x9a,0xd8,0xf5,0x88,0x4d,0x8f,0x50,0x14,0xb6,0xe4,0x4b,
+  0xc5,0x19,0xf9,0x90,0x8d,0x7a,0xa2,0x0e,0x7b,0x01,0xdb,0x36,0xe0,0x97,0x38,0xef,
+  0x70,0x8a,0x7c,0x9c,0x73,0xa3,0x0f,0x99,0x32,0x9a,0xa4,0xc5,0xb0,0x9b,0x21,0xce,
+  0x7c,0xbd,0x4c,0x91,0x38,0x20,0xae,0xc4,0x80,0x78,0xae,0xc1,0x34,0x02,0xed,0x94,
+  0xe1,0xa6,0xd8,0x5c,0x82,0x26,0xf7,0x21,0xd6,0x65,0x3b,0xd7,0x15,0xc8,0x1f,0x90,
+  0x83,0x7f,0x71,0xd0,0xa5,0xd8,0xe9,0x52,0xbb,0xee,0x43,0x2b,0xdb,0x51,0xdf,0x0a,
+  0x6c,0xfa,0xf3,0xfb,0xb7,0xe7,0x81,0x17,0x82,0x65,0xfd,0x24,0x63,0xaf,0x9f,0x3b,
+  0xf8,0x67,0x9d,0xb5,0x8b,0x60,0x98,0x53,0x34,0xce,0xdf,0xf8,0xcf,0x74,0x61,0xda,
+  0xe8,0x69,0x73,0x70,0x14,0x7b,0x3f,0xf3,0x31,0x58,0xfd,0x68,0x4a,0xd4,0x6c,0x9c,
+  0x68,0x79,0x00,0x15,0x3a,0xaf,0xa1,0xfd,0x14,0x24,0xdc,0xf5,0x6c,0x70,0x6e,0xed,
+  0xb9,0x64,0x31,0x06,0xdd,0xc4,0x14,0x63,0x78,0x5f,0x0d,0xc0,0xad,0xcb,0x88,0x8b,
+  0x77,0x73,0xbe,0x8e,0x28,0x7c,0x58,0x6b,0x5c,0x3c,0x24,0x52,0x85,0x6f,0x78,0x62,
+  0xa0,0xa7,0x9d,0x8b,0x14,0xd1,0xe0,0x12,0x7c,0x00,0xdb,0x9b,0x61,0xe8,0x32,0x21,
+  0xc0,0x08,0x76,0x90,0x77,0x77,0x03,0xf0,0x5c,0x6f,0x90,0x46,0xae,0x30,0x9c,0xad,
+  0xd5,0x57,0x23,0xdc,0xde,0xff,0x86,0xe5,0x63,0x4f,0xfb,0x92,0xfb,0x97,0x3a,0x49,
+  0xa8,0xeb,0x92,0x7c,0x50,0x7d,0x74,0xc0,0x98,0x2b,0x4c,0xcb,0xeb,0xd7,0x1b,0xf6,
+  0x11,0xab,0xb1,0xcc,0xc9,0xe2,0x70,0x46,0xfe,0x3a,0x7f,0xf7,0xd3,0x30,0xc4,0x8c,
+  0x5a,0xaf,0x5d,0xfb,0x4a,0x94,0xc2,0x7a,0xf0,0xe7,0x38,0xab,0xca,0x23,0xc3,0x35,
+  0x4d,0x5e,0xbb,0x14,0x5f,0x5f,0xdd,0xbf,0xb5,0x7b,0x9a,0x03,0x31,0xef,0x0a,0x93,
+  0x72,0x5a,0x5f,0xb8,0x78,0xd6,0x38,0xaf,0x58,0x0b,0x21,0xc7,0x7a,0xb9,0x79,0x31,
+  0xbe,0x71,0x72,0x03,0x23,0x6b,0xdf,0xc0,0xc8,0x3e,0xd5,0xc6,0xda,0x5a,0x3c,0x39,
+  0x95,0x64,0x83,0x37,0x43,0xe4,0xc5,0x19,0xd8,0x5a,0x10,0xcc,0x9d,0x5d,0x39,0xb0,
+  0x55,0xbb,0x12,0x4b,0xd5,0x06,0xc0,0x1a,0x49,0x67,0x70,0x31,0xb5,0x56,0xf1,0xb0,
+  0xb4,0x33,0x04,0x9f,0xb6,0xe2,0x98,0xd9,0xe3,0xaa,0xe6,0x8a,0x9a,0x6e,0x20,0xa1,
+  0x19,0xc7,0x77,0xb0,0x1b,0x6a,0x06,0xca,0x6b,0xbb,0x73,0xa4,0xb7,0x72,0xa4,0x6f,
+  0xc6,0x91,0xbe,0x92,0xa3,0x8e,0x60,0x72,0x6a,0xaf,0x2a,0xbb,0xa8,0xeb,0xac,0x72,
+  0xef,0xb7,0x24,0xb9,0x82,0x45,0x35,0x38,0x65,0x95,0x31,0xa5,0xaa,0x1b,0x4c,0x1a,
+  0xb7,0x80,0x60,0x45,0x37,0x88,0x4c,0x0f,0x8d,0x30,0x59,0x65,0x47,0x28,0x4c,0xa5,
+  0x37,0xc2,0x40,0x45,0x37,0x08,0x58,0x05,0x5d,0xd3,0x28,0x8c,0x98,0xdf,0x8c,0xa4,
+  0xd4,0xaf,0x05,0x0c,0xd3,0x85,0xcb,0x62,0x07,0x7a,0x17,0x3b,0xfa,0x9a,0x67,0xd6,
+  0x08,0x36,0x86,0xd4,0xd7,0x41,0xea,0x9d,0x21,0x71,0xd8,0xb6,0x72,0xc8,0x2b,0x37,
+  0x82,0xd2,0x57,0x41,0x75,0xe7,0x8a,0xcf,0x28,0x6d,0x50,0xbc,0x72,0x2d,0x54,0x9c,
+  0x2e,0x30,0xfd,0xb0,0xa0,0x57,0x32,0x33,0x59,0x93,0xb2,0x4e,0xb1,0x39,0xa8,0xbe,
+  0x16,0x54,0xdf,0x00,0xb4,0xd5,0x65,0x1a,0x48,0xb6,0x80,0xd5,0xd7,0xc3,0x6e,0xc2,
+  0x6d,0xa3,0xeb,0x54,0xaa,0x37,0x84,0xd3,0x57,0xc3,0x6d,0xc2,0x9d,0x65,0xba,0x6c,
+  0x11,0x35,0xb8,0x51,0x03,0xc9,0x06,0xb0,0x11,0x5d,0x04,0x41,0xd2,0x8e,0x29,0xea,
+  0x37,0x02,0x84,0x35,0xdf,0x2a,0x3c,0xa8,0x5e,0x0b,0x37,0x77,0x60,0x0e,0xa7,0xd1,
+  0xf8,0x2a,0xcb,0x1e,0x5e,0xd9,0xc1,0x9d,0x5f,0x45,0x6d,0xa6,0xea,0x0a,0xae,0x77,
+  0x02,0xd7,0xb7,0x03,0x57,0x78,0x4a,0xc3,0xf5,0x7c,0xa7,0xe1,0x16,0x5c,0xb7,0x02,
+  0xeb,0xdb,0x00,0x2b,0xdc,0xf0,0xb5,0x59,0x47,0x8d,0x17,0xb4,0x5b,0x48,0xb0,0xb6,
+  0x23,0xfd,0x31,0x1d,0x29,0x5c,0xca,0x25,0xde,0x1a,0x59,0x90,0x6a,0x0b,0x29,0x56,
+  0x80,0xeb,0x1b,0x82,0x7f,0x7f,0xf1,0xf6,0xdd,0xd5,0xdf,0x5e,0xff,0x5a,0x0b,0x43,
+  0x79,0x45,0x67,0x08,0xbd,0x0d,0x42,0xef,0x0c,0x31,0x69,0x83,0x98,0x74,0x86,0x38,
+  0x6c,0x83,0x38,0x3c,0xdb,0x53,0x36,0xc1,0x2d,0x9b,0x8c,0x7e,0xbe,0x73,0x5d,0x9b,
+  0xab,0x2b,0xe5,0x03,0xd6,0xe5,0xeb,0xf0,0x5f,0xad,0x77,0x65,0xbd,0xdf,0xde,0xaf,
+  0x92,0xaa,0x5b,0xdd,0xa3,0x20,0x2c,0x75,0x55,0xed,0xb1,0xb4,0x05,0x6a,0xed,0xb2,
+  0x94,0xb0,0x5b,0xd9,0x67,0x46,0xb9,0xb2,0xd3,0xfa,0x4a,0xbb,0xb5,0xe7,0x7a,0xda,
+  0x6e,0x65,0xf7,0x25,0x72,0xa5,0x73,0x91,0x3f,0xe0,0x1f,0x72,0x97,0xad,0x1e,0x43,
+  0x14,0xbb,0x75,0x35,0x7d,0x20,0x08,0xb3,0x93,0x07,0x7e,0x06,0x23,0x8f,0x5e,0xf6,
+  0xe0,0x5d,0x5e,0x4c,0x91,0xd7,0x54,0x78,0xd6,0x2b,0xf0,0xdd,0xc0,0xb4,0x67,0x5a,
+  0xe9,0x50,0x42,0x93,0x97,0x58,0x68,0x64,0x4c,0x9d,0x31,0xb1,0x5c,0x58,0x86,0xcf,
+  0x34,0x51,0xa2,0x11,0x06,0xe4,0x22,0xad,0xa7,0x19,0xa2,0x89,0x1c,0xaa,0xd0,0xc1,
+  0xd8,0x10,0xbd,0x40,0x4b,0x3c,0xf6,0xa1,0x22,0xb3,0x20,0x01,0xf2,0x23,0x6d,0xc0,
+  0x27,0x64,0x2a,0xae,0x17,0xc8,0x3a,0xe5,0xaa,0x85,0x86,0x29,0xb8,0x99,0xb2,0x25,
+  0x37,0xde,0xc0,0x2b,0xbf,0x32,0x33,0x1d,0xf1,0x46,0x06,0x99,0xf2,0x44,0x5e,0xd6,
+  0x18,0x8f,0xb8,0x35,0xc2,0x93,0x63,0x1a,0x1e,0x5d,0x69,0xf2,0x7e,0x4d,0x01,0xc1,
+  0x99,0x56,0x3e,0x03,0x5f,0xa4,0x29,0xa0,0xad,0x9a,0x1a,0xe7,0x49,0x05,0x66,0xef,
+  0xf3,0xa7,0x48,0x75,0x71,0x65,0x8c,0xa4,0x24,0x28,0x94,0xa3,0x1b,0x32,0x48,0xf1,
+  0x1e,0x41,0x5e,0xdd,0x58,0x27,0x6a,0x89,0xdb,0x3c,0x7b,0x27,0x39,0x2e,0xbe,0xe5,
+  0xad,0x20,0xee,0x8e,0x9c,0x63,0xf9,0xda,0x85,0xdb,0x3c,0xc7,0xa7,0x19,0x6b,0x55,
+  0x2b,0x60,0x8d,0x5f,0xf0,0x91,0xa9,0x74,0x63,0x36,0xf9,0x48,0xe5,0x5c,0x8a,0xb7,
+  0x5d,0x33,0xc9,0x51,0x8d,0x4b,0xf8,0xbb,0x35,0x8b,0xf5,0xec,0x07,0xe7,0xb7,0xa1,
+  0x78,0xd7,0xcc,0xd7,0xbb,0x30,0x5e,0x42,0x11,0xc1,0x22,0x22,0x8b,0x54,0xb1,0xd6,
+  0xc0,0x89,0xdc,0x92,0xf1,0x05,0x09,0x96,0x24,0x16,0xce,0x17,0x9f,0xaa,0xed,0xe5,
+  0x35,0x9e,0xd2,0x78,0x10,0x3a,0x10,0x4d,0xb9,0xdc,0xf2,0x75,0x33,0xdf,0xc7,0x48,
+  0x34,0x0d,0xc4,0x1d,0x28,0x91,0x9b,0xd6,0xc6,0x9a,0x31,0x9e,0x8e,0x44,0x59,0x23,
+  0x81,0xae,0x19,0xba,0x4a,0x80,0xe3,0x07,0xf9,0xab,0x8f,0xa4,0x7f,0xb0,0xef,0xd8,
+  0xee,0x47,0x90,0x12,0x51,0xb9,0xe0,0xea,0xf7,0xae,0x2d,0xad,0x60,0x73,0x69,0x08,
+  0x7f,0xdf,0xc0,0xb6,0x22,0xfb,0x65,0xcc,0xe7,0x6f,0xbf,0x25,0xe3,0xce,0x01,0xce,
+  0x33,0x3f,0x8a,0x13,0x09,0xd0,0xf6,0x61,0x49,0x6e,0x81,0x57,0xc8,0x2d,0xbf,0x37,
+  0xb5,0xfa,0x3a,0xb6,0x8b,0x7c,0x9b,0x91,0xbd,0x76,0x62,0x3f,0xcf,0xf7,0xac,0x10,
+  0xa1,0xc0,0x2e,0xc4,0x50,0xca,0x36,0x14,0x65,0x95,0x30,0x44,0x75,0x8d,0xdc,0x1c,
+  0xba,0x34,0x87,0x9e,0xc9,0x23,0xc5,0xe9,0x6e,0x00,0x5d,0xcb,0x3a,0x53,0x6e,0x51,
+  0x0a,0x35,0x94,0x0c,0xa3,0xef,0xd0,0x30,0x75,0x59,0x8a,0x0c,0x64,0x61,0xa3,0x66,
+  0x99,0x36,0xb1,0x4a,0x17,0xd9,0x14,0xda,0xad,0xa7,0x5a,0x58,0xf9,0x60,0x88,0xf8,
+  0xf1,0xef,0x97,0x97,0x9d,0x42,0xc4,0x1a,0x87,0x55,0xf3,0x9e,0xc6,0x9c,0x3f,0x1f,
+  0x37,0xda,0x54,0x40,0x2e,0x79,0xa9,0x60,0x4b,0xb3,0xae,0xe1,0x9f,0x27,0x5c,0x8d,
+  0x9f,0xe3,0x9d,0xf0,0xce,0xc1,0x0a,0xce,0xc5,0xe7,0xd3,0xf0,0x9d,0xfb,0x97,0x71,
+  0x21,0xdf,0x1e,0x1f,0x2a,0xca,0xc0,0x85,0x1c,0x45,0xd1,0x13,0xc9,0x82,0x69,0x66,
+  0xe3,0x02,0xfe,0x76,0x90,0xc1,0x4f,0xbd,0x05,0xaa,0xd5,0x63,0x3e,0x4e,0x9c,0x28,
+  0xc9,0x4c,0x3b,0x3e,0x3a,0x9a,0x1c,0x95,0xc5,0xe0,0xb7,0xc0,0x0b,0x11,0xf8,0xe7,
+  0xd3,0xb0,0xaf,0xa6,0xb8,0x8d,0xcb,0x1f,0xe6,0x44,0x29,0xd8,0xc6,0xa9,0x8e,0xbe,
+  0x2e,0x49,0xa2,0xc2,0x17,0x02,0x95,0x4a,0x43,0xd7,0xb4,0x28,0xae,0x84,0x28,0xf0,
+  0xf4,0xf2,0xe5,0xe9,0xab,0x57,0xa7,0xc3,0x21,0xe9,0xcd,0xdf,0xbc,0x1c,0xef,0x13,
+  0xe4,0x68,0x91,0x32,0x3c,0xc9,0xc7,0x1b,0xb4,0xfd,0xed,0x03,0x08,0xdf,0x39,0x41,
+  0x08,0x99,0x18,0x17,0x22,0x61,0x4c,0xf8,0x45,0x46,0x58,0x77,0x41,0xd1,0x46,0xc1,
+  0x84,0x5f,0x8f,0xd5,0xf2,0x65,0xff,0xb8,0x75,0x76,0x97,0x57,0x64,0x95,0x6d,0x73,
+  0xde,0x28,0x8f,0xbb,0x7b,0x2b,0x63,0x15,0xf8,0x95,0x48,0xc0,0xb6,0x2e,0x7a,0x05,
+  0x33,0x6d,0xd6,0x38,0xcc,0xad,0x51,0x3f,0x7e,0xe0,0xe6,0x68,0x28,0xde,0xd8,0xcf,
+  0x4a,0xfc,0xd4,0x65,0xde,0x9c,0x37,0xbd,0x99,0xb7,0x8d,0x67,0x8f,0x95,0xd3,0x63,
+  0xb1,0xa1,0x20,0x61,0x27,0x25,0x8b,0x16,0xdd,0xa5,0x11,0x79,0xf0,0x92,0x24,0xb2,
+  0x68,0xc7,0x1a,0xde,0x86,0x31,0xbd,0xce,0xd8,0x4e,0xd5,0x9b,0x2d,0x39,0x4a,0x07,
+  0x37,0x06,0x1e,0xd8,0x13,0xfe,0xde,0xae,0xea,0x55,0xc1,0xa5,0x2e,0x8b,0x00,0x2e,
+  0xc9,0x22,0x8b,0x4a,0x61,0x65,0x11,0x24,0x0e,0x91,0xda,0x92,0x17,0x93,0x3c,0x1a,
+  0xc7,0xe6,0x35,0x25,0xbd,0x82,0xa9,0x1d,0x45,0x9a,0x2c,0xce,0xcc,0xb3,0x6c,0xfd,
+  0x1f,0x24,0xd2,0x10,0xb2,0x3a,0xd6,0x9c,0xcb,0xab,0xfa,0x8f,0x8e,0x35,0x0d,0x67,
+  0x6c,0xdc,0x42,0x4d,0xe5,0x9f,0x3f,0xda,0x34,0x1c,0xd6,0x35,0x73,0xb7,0xc5,0x6a,
+  0x7c,0xb5,0x82,0xe7,0xb4,0x6b,0xac,0xd9,0x48,0x8c,0x4a,0x48,0x6f,0xac,0xf8,0x3d,
+  0xd5,0x5c,0x09,0xeb,0x8d,0x15,0x3b,0x0f,0xec,0xd3,0xc4,0xe6,0xfa,0x4e,0x76,0x1f,
+  0xe0,0xab,0x47,0x9d,0x15,0xa9,0x7e,0xdf,0x20,0x5f,0x3d,0x38,0x6d,0x60,0x6e,0x2b,
+  0x75,0xdb,0xec,0xb6,0x92,0xf9,0x35,0xa6,0x23,0x28,0xec,0x94,0xd3,0x68,0x38,0x7d,
+  0x35,0xce,0xb3,0xd7,0x6d,0x56,0x99,0x8d,0xa3,0x39,0xc7,0xae,0x0e,0xe7,0xa2,0x62,
+  0x23,0xb9,0xa7,0xa3,0x45,0xb4,0x99,0x78,0xf2,0x14,0xd8,0x78,0xcf,0x9f,0xbb,0x12,
+  0x4c,0xa2,0x56,0xa4,0xca,0x4a,0x9f,0x5c,0x24,0x3c,0x87,0x06,0x89,0xe0,0xb1,0x3b,
+  0x81,0x10,0xb3,0x26,0x0f,0x2f,0xdc,0x42,0x9c,0x6a,0x16,0xf1,0xc2,0x8c,0xa0,0x43,
+  0x4c,0x8a,0x6e,0x9e,0x28,0xf8,0xbc,0x33,0xee,0xb7,0xf2,0xa8,0x84,0xe0,0x79,0xac,
+  0xda,0x95,0x32,0xda,0x24,0x47,0xa5,0xfc,0x4c,0x69,0x1b,0x79,0x20,0xb7,0x91,0x63,
+  0xfd,0x00,0xfe,0x65,0xda,0x6e,0x39,0xfa,0xe7,0x4a,0x6f,0xab,0xdb,0x48,0xf7,0xc4,
+  0x8b,0x8b,0x00,0xa0,0xf0,0xdb,0xa0,0x98,0x2d,0x79,0xd7,0x57,0xf0,0xae,0xef,0x8c,
+  0xf7,0x8e,0x16,0x4a,0xc3,0xa7,0xb6,0x4f,0x1a,0xb6,0x59,0x07,0x6b,0xfe,0xb8,0xb6,
+  0xa9,0xf0,0xad,0xef,0x88,0xef,0x95,0x73,0xbc,0x3c,0xb2,0xc2,0x49,0x3e,0xb7,0x10,
+  0x96,0xad,0xb2,0x51,0xde,0xe8,0xd1,0x96,0x52,0xee,0x5b,0xb4,0x58,0x4c,0xa5,0xd8,
+  0xa5,0xe5,0xc4,0x2f,0xf4,0x77,0x6b,0xbf,0x16,0x69,0xf4,0x9d,0x4a,0xd3,0x61,0xc5,
+  0x96,0x1b,0x32,0xa9,0x1c,0xf2,0xd5,0x0c,0x29,0x57,0x78,0x8f,0xb6,0x63,0x71,0x66,
+  0xd9,0x56,0xf7,0x34,0xa3,0xee,0x71,0x02,0xe8,0x2b,0x04,0xd0,0x77,0x24,0x40,0x3d,
+  0xef,0x2e,0x7e,0xe2,0x48,0xde,0x8e,0xde,0xc5,0xbb,0x48,0xbf,0x17,0x37,0x74,0x8a,
+  0xb9,0x56,0x89,0xb1,0x5d,0x53,0xa8,0xb9,0xa2,0x8e,0x33,0x25,0x15,0xc0,0x5c,0x2f,
+  0xca,0xe7,0x93,0x2c,0x94,0x8a,0x6b,0x42,0x8a,0x1c,0xea,0x6c,0xfe,0x78,0x49,0xf4,
+  0xb2,0x24,0xfa,0xae,0x25,0x29,0x6d,0xeb,0x4a,0x42,0x4d,0x94,0x35,0xcd,0x6a,0xe3,
+  0x34,0x6c,0x0d,0x3b,0x4a,0x37,0xd1,0x48,0x49,0xbc,0xc9,0xe7,0x13,0xef,0x50,0x15,
+  0x6f,0x8d,0xcd,0xb6,0x17,0xf0,0xb0,0x6c,0xbe,0xc3,0x6d,0xe4,0xab,0xad,0x73,0xa7,
+  0x8b,0x88,0x8c,0x1a,0xef,0xd4,0x88,0x14,0x0e,0xe6,0xa3,0xe4,0x2f,0xf1,0x05,0xb3,
+  0xe2,0x23,0x3f,0xaa,0x2b,0x16,0xdb,0x2e,0xb3,0x6e,0x66,0x5a,0xfd,0xb7,0x4f,0x9a,
+  0xf1,0xca,0xb4,0x6e,0xa0,0x63,0xde,0xb0,0x2b,0x9c,0x17,0xa4,0x31,0x4d,0x43,0x4c,
+  0xc6,0xe5,0xbf,0xe8,0x3e,0x39,0xe9,0x6b,0xc6,0x0f,0x81,0x69,0x13,0x9b,0x2e,0xcd,
+  0xd4,0xc5,0x4b,0x26,0x5b,0xa2,0xaa,0x3f,0xf4,0x03,0xe3,0xc1,0x97,0xfa,0x9b,0x41,
+  0x05,0x56,0xd1,0xd4,0x08,0x2f,0x36,0xe1,0x53,0xdc,0x73,0xfa,0x2f,0x7b,0xd8,0x48,
+  0xf6,0xa6,0x47,0x00,0x00,
+};
+
+#endif
@@ -6,9 +6,16 @@
 
 #include "PubSubClient.h"
 #include "Arduino.h"
+#include <limits.h>
 
 PubSubClient::PubSubClient() {
     this->_state = MQTT_DISCONNECTED;
+    initInflight();
+    initQueue();
+    this->viewCallback = NULL;
+    initBuffers();
+    initProtocol();
+    clearFilters();
     this->_client = NULL;
     this->stream = NULL;
     setCallback(NULL);
@@ -16,24 +23,48 @@ PubSubClient::PubSubClient() {
 
 PubSubClient::PubSubClient(Client& client) {
     this->_state = MQTT_DISCONNECTED;
+    initInflight();
+    initQueue();
+    this->viewCallback = NULL;
+    initBuffers();
+    initProtocol();
+    clearFilters();
     setClient(client);
     this->stream = NULL;
 }
 
 PubSubClient::PubSubClient(IPAddress addr, uint16_t port, Client& client) {
     this->_state = MQTT_DISCONNECTED;
+    initInflight();
+    initQueue();
+    this->viewCallback = NULL;
+    initBuffers();
+    initProtocol();
+    clearFilters();
     setServer(addr, port);
     setClient(client);
     this->stream = NULL;
 }
 PubSubClient::PubSubClient(IPAddress addr, uint16_t port, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
+    initInflight();
+    initQueue();
+    this->viewCallback = NULL;
+    initBuffers();
+    initProtocol();
+    clearFilters();
     setServer(addr,port);
     setClient(client);
     setStream(stream);
 }
 PubSubClient::PubSubClient(IPAddress addr, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client) {
     this->_state = MQTT_DISCONNECTED;
+    initInflight();
+    initQueue();
+    this->viewCallback = NULL;
+    initBuffers();
+    initProtocol();
+    clearFilters();
     setServer(addr, port);
     setCallback(callback);
     setClient(client);
@@ -41,6 +72,12 @@ PubSubClient::PubSubClient(IPAddress addr, uint16_t port, MQTT_CALLBACK_SIGNATUR
 }
 PubSubClient::PubSubClient(IPAddress addr, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
+    initInflight();
+    initQueue();
+    this->viewCallback = NULL;
+    initBuffers();
+    initProtocol();
+    clearFilters();
     setServer(addr,port);
     setCallback(callback);
     setClient(client);
@@ -49,18 +86,36 @@ PubSubClient::PubSubClient(IPAddress addr, uint16_t port, MQTT_CALLBACK_SIGNATUR
 
 PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, Client& client) {
     this->_state = MQTT_DISCONNECTED;
+    initInflight();
+    initQueue();
+    this->viewCallback = NULL;
+    initBuffers();
+    initProtocol();
+    clearFilters();
     setServer(ip, port);
     setClient(client);
     this->stream = NULL;
 }
 PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
+    initInflight();
+    initQueue();
+    this->viewCallback = NULL;
+    initBuffers();
+    initProtocol();
+    clearFilters();
     setServer(ip,port);
     setClient(client);
     setStream(stream);
 }
 PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client) {
     this->_state = MQTT_DISCONNECTED;
+    initInflight();
+    initQueue();
+    this->viewCallback = NULL;
+    initBuffers();
+    initProtocol();
+    clearFilters();
     setServer(ip, port);
     setCallback(callback);
     setClient(client);
@@ -68,6 +123,12 @@ PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, MQTT_CALLBACK_SIGNATURE,
 }
 PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
+    initInflight();
+    initQueue();
+    this->viewCallback = NULL;
+    initBuffers();
+    initProtocol();
+    clearFilters();
     setServer(ip,port);
     setCallback(callback);
     setClient(client);
@@ -76,18 +137,36 @@ PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, MQTT_CALLBACK_SIGNATURE,
 
 PubSubClient::PubSubClient(const char* domain, uint16_t port, Client& client) {
     this->_state = MQTT_DISCONNECTED;
+    initInflight();
+    initQueue();
+    this->viewCallback = NULL;
+    initBuffers();
+    initProtocol();
+    clearFilters();
     setServer(domain,port);
     setClient(client);
     this->stream = NULL;
 }
 PubSubClient::PubSubClient(const char* domain, uint16_t port, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
+    initInflight();
+    initQueue();
+    this->viewCallback = NULL;
+    initBuffers();
+    initProtocol();
+    clearFilters();
     setServer(domain,port);
     setClient(client);
     setStream(stream);
 }
 PubSubClient::PubSubClient(const char* domain, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client) {
     this->_state = MQTT_DISCONNECTED;
+    initInflight();
+    initQueue();
+    this->viewCallback = NULL;
+    initBuffers();
+    initProtocol();
+    clearFilters();
     setServer(domain,port);
     setCallback(callback);
     setClient(client);
@@ -95,12 +174,22 @@ PubSubClient::PubSubClient(const char* domain, uint16_t port, MQTT_CALLBACK_SIGN
 }
 PubSubClient::PubSubClient(const char* domain, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
+    initInflight();
+    initQueue();
+    this->viewCallback = NULL;
+    initBuffers();
+    initProtocol();
+    clearFilters();
     setServer(domain,port);
     setCallback(callback);
     setClient(client);
     setStream(stream);
 }
 
+PubSubClient::~PubSubClient() {
+    freeBuffers();
+}
+
 boolean PubSubClient::connect(const char *id) {
     return connect(id,NULL,NULL,0,0,0,0,1);
 }
@@ -118,9 +207,36 @@ boolean PubSubClient::connect(const char *id, const char *user, const char *pass
 }
 
 boolean PubSubClient::connect(const char *id, const char *user, const char *pass, const char* willTopic, uint8_t willQos, boolean willRetain, const char* willMessage, boolean cleanSession) {
+    if (!beginConnect(id,user,pass,willTopic,willQos,willRetain,willMessage,cleanSession)) {
+        return false;
+    }
+    int rc;
+    while ((rc = connectPoll()) == MQTT_POLL_IN_PROGRESS) {
+        yield();
+    }
+    return rc == MQTT_POLL_CONNECTED;
+}
+
+boolean PubSubClient::beginConnect(const char *id) {
+    return beginConnect(id,NULL,NULL,0,0,0,0,1);
+}
+
+boolean PubSubClient::beginConnect(const char *id, const char *user, const char *pass) {
+    return beginConnect(id,user,pass,0,0,0,0,1);
+}
+
+boolean PubSubClient::beginConnect(const char *id, const char *user, const char *pass, const char* willTopic, uint8_t willQos, boolean willRetain, const char* willMessage, boolean cleanSession) {
     if (!connected()) {
         int result = 0;
 
+        if (buffer == NULL) {
+            _state = MQTT_CONNECT_FAILED;
+            return false;
+        }
+        if (_state == MQTT_CONNECTING) {
+            // Start again
+            _client->stop();
+        }
         if (domain != NULL) {
             result = _client->connect(this->domain, this->port);
         } else {
@@ -128,10 +244,28 @@ boolean PubSubClient::connect(const char *id, const char *user, const char *pass
         }
         if (result == 1) {
             nextMsgId = 1;
+            subscribesPending = 0;
+            // Aliases and limits belong to one connection
+            for (uint8_t i = 0;i<MQTT_TOPIC_ALIASES;i++) {
+                aliases[i][0] = 0;
+            }
+            serverReceiveMax = 0xFFFF;
+            serverAliasMax = 0;
+            sessionPresentFlag = false;
             // Leave room in the buffer for header and variable length field
             uint16_t length = MQTT_MAX_HEADER_SIZE;
             unsigned int j;
+            // Protocol name and version, flags, keepalive and the properties
+            if (this->bufferSize < MQTT_MAX_HEADER_SIZE + 18) {
+                _client->stop();
+                return false;
+            }
 
+            if (protocolVersion == MQTT_VERSION_5) {
+                uint8_t d5[7] = {0x00,0x04,'M','Q','T','T',MQTT_VERSION_5};
+                memcpy(buffer+length,d5,7);
+                length += 7;
+            } else {
 #if MQTT_VERSION == MQTT_VERSION_3_1
             uint8_t d[9] = {0x00,0x06,'M','Q','I','s','d','p', MQTT_VERSION};
 #define MQTT_HEADER_VERSION_LENGTH 9
@@ -142,6 +276,7 @@ boolean PubSubClient::connect(const char *id, const char *user, const char *pass
             for (j = 0;j<MQTT_HEADER_VERSION_LENGTH;j++) {
                 buffer[length++] = d[j];
             }
+            }
 
             uint8_t v;
             if (willTopic) {
@@ -163,12 +298,30 @@ boolean PubSubClient::connect(const char *id, const char *user, const char *pass
 
             buffer[length++] = v;
 
-            buffer[length++] = ((MQTT_KEEPALIVE) >> 8);
-            buffer[length++] = ((MQTT_KEEPALIVE) & 0xFF);
+            buffer[length++] = ((this->keepAlive) >> 8);
+            buffer[length++] = ((this->keepAlive) & 0xFF);
+
+            if (protocolVersion == MQTT_VERSION_5) {
+                // Properties
+                if (sessionExpiry > 0) {
+                    buffer[length++] = 5;
+                    buffer[length++] = 0x11;  // Session Expiry Interval
+                    buffer[length++] = (sessionExpiry >> 24);
+                    buffer[length++] = (sessionExpiry >> 16) & 0xFF;
+                    buffer[length++] = (sessionExpiry >> 8) & 0xFF;
+                    buffer[length++] = (sessionExpiry & 0xFF);
+                } else {
+                    buffer[length++] = 0;
+                }
+            }
 
             CHECK_STRING_LENGTH(length,id)
             length = writeString(id,buffer,length);
             if (willTopic) {
+                if (protocolVersion == MQTT_VERSION_5) {
+                    CHECK_STRING_LENGTH(length+1,willTopic)
+                    buffer[length++] = 0;  // no will properties
+                }
                 CHECK_STRING_LENGTH(length,willTopic)
                 length = writeString(willTopic,buffer,length);
                 CHECK_STRING_LENGTH(length,willMessage)
@@ -186,45 +339,80 @@ boolean PubSubClient::connect(const char *id, const char *user, const char *pass
 
             write(MQTTCONNECT,buffer,length-MQTT_MAX_HEADER_SIZE);
 
-            lastInActivity = lastOutActivity = millis();
+            lastInActivity = lastOutActivity = now();
+            _state = MQTT_CONNECTING;
+            return true;
+        }
+        _state = MQTT_CONNECT_FAILED;
+        return false;
+    }
+    return true;
+}
 
-            while (!_client->available()) {
-                unsigned long t = millis();
-                if (t-lastInActivity >= ((int32_t) MQTT_SOCKET_TIMEOUT*1000UL)) {
-                    _state = MQTT_CONNECTION_TIMEOUT;
-                    _client->stop();
-                    return false;
-                }
+int PubSubClient::connectPoll() {
+    if (_state != MQTT_CONNECTING) {
+        return connected() ? MQTT_POLL_CONNECTED : MQTT_POLL_FAILED;
+    }
+    if (!_client->available()) {
+        if (!_client->connected()) {
+            _state = MQTT_CONNECT_FAILED;
+            _client->stop();
+            return MQTT_POLL_FAILED;
+        }
+        if (now()-lastInActivity >= this->socketTimeout*1000UL) {
+            _state = MQTT_CONNECTION_TIMEOUT;
+            _client->stop();
+            return MQTT_POLL_FAILED;
+        }
+        return MQTT_POLL_IN_PROGRESS;
+    }
+    uint8_t llen;
+    uint16_t len = readPacket(&llen);
+
+    // 3.1.1: flags and return code, MQTT 5: flags, reason code and properties
+    if ((rxBuffer[0]&0xF0) == MQTTCONNACK && (protocolVersion == MQTT_VERSION_5 ? len >= llen+4 : len == 4)) {
+        uint8_t rc = rxBuffer[llen+2];
+        if (rc == 0) {
+            sessionPresentFlag = rxBuffer[llen+1] & 1;
+            if (protocolVersion == MQTT_VERSION_5) {
+                readConnackProperties(llen+3,len);
             }
-            uint8_t llen;
-            uint16_t len = readPacket(&llen);
-
-            if (len == 4) {
-                if (buffer[3] == 0) {
-                    lastInActivity = millis();
-                    pingOutstanding = false;
-                    _state = MQTT_CONNECTED;
-                    return true;
-                } else {
-                    _state = buffer[3];
-                }
+            lastInActivity = now();
+            pingOutstanding = false;
+            _state = MQTT_CONNECTED;
+            resendInflight();
+            flushQueue();
+            return MQTT_POLL_CONNECTED;
+        } else if (protocolVersion == MQTT_VERSION_5) {
+            switch (rc) {
+                case 0x84: _state = MQTT_CONNECT_BAD_PROTOCOL; break;
+                case 0x85: _state = MQTT_CONNECT_BAD_CLIENT_ID; break;
+                case 0x86: _state = MQTT_CONNECT_BAD_CREDENTIALS; break;
+                case 0x87: _state = MQTT_CONNECT_UNAUTHORIZED; break;
+                case 0x88:
+                case 0x89: _state = MQTT_CONNECT_UNAVAILABLE; break;
+                default: _state = MQTT_CONNECT_FAILED;
             }
-            _client->stop();
         } else {
-            _state = MQTT_CONNECT_FAILED;
+            _state = rc;
         }
-        return false;
+    } else {
+        _state = MQTT_CONNECT_FAILED;
     }
-    return true;
+    _client->stop();
+    return MQTT_POLL_FAILED;
 }
 
 // reads a byte into result
 boolean PubSubClient::readByte(uint8_t * result) {
-   uint32_t previousMillis = millis();
+   uint32_t previousMillis = now();
    while(!_client->available()) {
+     if (!_client->connected()) {
+       return false;
+     }
      yield();
-     uint32_t currentMillis = millis();
-     if(currentMillis - previousMillis >= ((int32_t) MQTT_SOCKET_TIMEOUT * 1000)){
+     uint32_t currentMillis = now();
+     if(currentMillis - previousMillis >= this->socketTimeout * 1000UL){
        return false;
      }
    }
@@ -232,89 +420,202 @@ boolean PubSubClient::readByte(uint8_t * result) {
    return true;
 }
 
-// reads a byte into result[*index] and increments index
-boolean PubSubClient::readByte(uint8_t * result, uint16_t * index){
-  uint16_t current_index = *index;
-  uint8_t * write_address = &(result[current_index]);
-  if(readByte(write_address)){
-    *index = current_index + 1;
+// reads length bytes into result, as many at once as the client has available
+boolean PubSubClient::readBytes(uint8_t * result, uint32_t length) {
+    uint32_t previousMillis = now();
+    while (length > 0) {
+        int n = _client->available();
+        if (n <= 0) {
+            if (!_client->connected()) {
+                // Closed in the middle of a packet - nothing more will come
+                return false;
+            }
+            yield();
+            uint32_t currentMillis = now();
+            if(currentMillis - previousMillis >= this->socketTimeout * 1000UL){
+                return false;
+            }
+            continue;
+        }
+        if ((uint32_t)n > length) {
+            n = length;
+        }
+        n = _client->read(result, n);
+        if (n > 0) {
+            result += n;
+            length -= n;
+            previousMillis = now();
+        }
+    }
+    return true;
+}
+
+// reads length bytes in buffer sized parts and forgets them
+boolean PubSubClient::skipBytes(uint32_t length) {
+    while (length > 0) {
+        uint32_t n = (length > rxBufferSize) ? rxBufferSize : length;
+        if(!readBytes(rxBuffer, n)) return false;
+        length -= n;
+    }
     return true;
-  }
-  return false;
 }
 
 uint16_t PubSubClient::readPacket(uint8_t* lengthLength) {
     uint16_t len = 0;
-    if(!readByte(buffer, &len)) return 0;
-    bool isPublish = (buffer[0]&0xF0) == MQTTPUBLISH;
+    chunked = false;
+    // Fixed header and the first byte of the remaining length - the shortest packet
+    if(!readBytes(rxBuffer, 2)) return 0;
+    len = 2;
+    bool isPublish = (rxBuffer[0]&0xF0) == MQTTPUBLISH;
     uint32_t multiplier = 1;
-    uint16_t length = 0;
-    uint8_t digit = 0;
+    uint8_t digit = rxBuffer[1];
+    uint32_t length = digit & 127;
     uint16_t skip = 0;
     uint8_t start = 0;
 
-    do {
+    while ((digit & 128) != 0) {
         if (len == 5) {
             // Invalid remaining length encoding - kill the connection
             _state = MQTT_DISCONNECTED;
             _client->stop();
             return 0;
         }
-        if(!readByte(&digit)) return 0;
-        buffer[len++] = digit;
-        length += (digit & 127) * multiplier;
+        if(!readBytes(rxBuffer+len, 1)) return 0;
+        digit = rxBuffer[len++];
         multiplier *= 128;
-    } while ((digit & 128) != 0);
+        length += (digit & 127) * multiplier;
+    }
     *lengthLength = len-1;
 
     if (isPublish) {
+        if (length < 2) {
+            // No room for the topic length - kill the connection
+            _state = MQTT_DISCONNECTED;
+            _client->stop();
+            return 0;
+        }
         // Read in topic length to calculate bytes to skip over for Stream writing
-        if(!readByte(buffer, &len)) return 0;
-        if(!readByte(buffer, &len)) return 0;
-        skip = (buffer[*lengthLength+1]<<8)+buffer[*lengthLength+2];
+        if(!readBytes(rxBuffer+len, 2)) return 0;
+        len += 2;
+        skip = (rxBuffer[*lengthLength+1]<<8)+rxBuffer[*lengthLength+2];
         start = 2;
-        if (buffer[0]&MQTTQOS1) {
+        if (rxBuffer[0]&MQTTQOS1) {
             // skip message id
             skip += 2;
         }
+        if (!this->stream && chunkCallback && len+length-start > rxBufferSize && len+skip < rxBufferSize && skip+start <= length) {
+            // Payload doesn't fit - topic (and msgId) stay at the start of the buffer, the payload goes through the rest
+            uint16_t tl = (rxBuffer[*lengthLength+1]<<8)+rxBuffer[*lengthLength+2];
+            if(!readBytes(rxBuffer+len, skip)) return 0;
+            len += skip;
+            if (protocolVersion == MQTT_VERSION_5) {
+                // Properties are kept in the buffer too
+                uint32_t plen = 0;
+                uint8_t shift = 0;
+                do {
+                    if ((uint32_t)(len-*lengthLength-1) >= length || shift > 21) {
+                        // Property length past the end of the packet or longer than 4 bytes - kill the connection
+                        _state = MQTT_DISCONNECTED;
+                        _client->stop();
+                        return 0;
+                    }
+                    if (len >= rxBufferSize) {
+                        skipBytes(length-(len-*lengthLength-1));
+                        rxDropped++;
+                        return 0;
+                    }
+                    if(!readBytes(rxBuffer+len, 1)) return 0;
+                    digit = rxBuffer[len++];
+                    plen += (uint32_t)(digit & 127) << shift;
+                    shift += 7;
+                } while ((digit & 128) != 0);
+                if ((uint32_t)(len-*lengthLength-1)+plen > length) {
+                    // Properties longer than the packet
+                    _state = MQTT_DISCONNECTED;
+                    _client->stop();
+                    return 0;
+                }
+                if (len+plen >= rxBufferSize) {
+                    skipBytes(length-(len-*lengthLength-1));
+                    rxDropped++;
+                    return 0;
+                }
+                if(!readBytes(rxBuffer+len, plen)) return 0;
+                len += plen;
+            }
+            uint32_t plength = length-(len-*lengthLength-1);
+            uint32_t offset = 0;
+            while (offset < plength) {
+                uint32_t n = plength-offset;
+                if (n > (uint32_t)(rxBufferSize-len)) {
+                    n = rxBufferSize-len;
+                }
+                if(!readBytes(rxBuffer+len, n)) return 0;
+                chunkCallback((const char*)rxBuffer+*lengthLength+3,tl,rxBuffer+len,n,offset,plength);
+                offset += n;
+            }
+            chunked = true;
+            return len;
+        }
     }
 
-    for (uint16_t i = start;i<length;i++) {
-        if(!readByte(&digit)) return 0;
-        if (this->stream) {
-            if (isPublish && len-*lengthLength-2>skip) {
+    if (this->stream) {
+        // The whole payload goes to the stream, the buffer keeps only what fits - the callback gets that part
+        for (uint32_t i = start;i<length;i++) {
+            if(!readByte(&digit)) return 0;
+            if (isPublish && i-start >= skip) {
                 this->stream->write(digit);
             }
+            if (len < rxBufferSize) {
+                rxBuffer[len++] = digit;
+            }
         }
-        if (len < MQTT_MAX_PACKET_SIZE) {
-            buffer[len] = digit;
+        if (isPublish && skip+start <= length && len < *lengthLength+3+skip) {
+            // Topic (and msgId) not in the buffer
+            rxDropped++;
+            return 0; // This will cause the packet to be ignored.
         }
-        len++;
+        return len;
     }
 
-    if (!this->stream && len > MQTT_MAX_PACKET_SIZE) {
-        len = 0; // This will cause the packet to be ignored.
+    uint32_t rest = (length > start) ? length-start : 0;
+    if (len+rest > rxBufferSize) {
+        // Doesn't fit - read it out and drop it
+        skipBytes(rest);
+        rxDropped++;
+        return 0; // This will cause the packet to be ignored.
     }
+    if(!readBytes(rxBuffer+len, rest)) return 0;
+    len += rest;
 
     return len;
 }
 
 boolean PubSubClient::loop() {
     if (connected()) {
-        unsigned long t = millis();
-        if ((t - lastInActivity > MQTT_KEEPALIVE*1000UL) || (t - lastOutActivity > MQTT_KEEPALIVE*1000UL)) {
-            if (pingOutstanding) {
+        if (queueCount > 0) {
+            // What didn't fit into the in-flight window after CONNACK
+            flushQueue();
+        }
+        unsigned long t = now();
+        unsigned long interval = this->keepAlive*1000UL;
+        if (interval == 0) {
+            // No keepalive
+        } else if (pingOutstanding) {
+            // Nothing at all from the server for a whole interval since the ping
+            if (t - lastInActivity > interval) {
                 this->_state = MQTT_CONNECTION_TIMEOUT;
                 _client->stop();
                 return false;
-            } else {
-                buffer[0] = MQTTPINGREQ;
-                buffer[1] = 0;
-                _client->write(buffer,2);
-                lastOutActivity = t;
-                lastInActivity = t;
-                pingOutstanding = true;
             }
+        } else if (t - lastOutActivity > interval) {
+            // Only when nothing else was sent - any packet to the server keeps the connection alive
+            buffer[0] = MQTTPINGREQ;
+            buffer[1] = 0;
+            _client->write(buffer,2);
+            lastOutActivity = t;
+            lastInActivity = t;
+            pingOutstanding = true;
         }
         if (_client->available()) {
             uint8_t llen;
@@ -323,30 +624,78 @@ boolean PubSubClient::loop() {
             uint8_t *payload;
             if (len > 0) {
                 lastInActivity = t;
-                uint8_t type = buffer[0]&0xF0;
+                uint8_t type = rxBuffer[0]&0xF0;
                 if (type == MQTTPUBLISH) {
-                    if (callback) {
-                        uint16_t tl = (buffer[llen+1]<<8)+buffer[llen+2]; /* topic length in bytes */
-                        memmove(buffer+llen+2,buffer+llen+3,tl); /* move topic inside buffer 1 byte to front */
-                        buffer[llen+2+tl] = 0; /* end the topic as a 'C' string with \x00 */
-                        char *topic = (char*) buffer+llen+2;
-                        // msgId only present for QOS>0
-                        if ((buffer[0]&0x06) == MQTTQOS1) {
-                            msgId = (buffer[llen+3+tl]<<8)+buffer[llen+3+tl+1];
-                            payload = buffer+llen+3+tl+2;
-                            callback(topic,payload,len-llen-3-tl-2);
-
-                            buffer[0] = MQTTPUBACK;
-                            buffer[1] = 2;
-                            buffer[2] = (msgId >> 8);
-                            buffer[3] = (msgId & 0xFF);
-                            _client->write(buffer,4);
-                            lastOutActivity = t;
-
-                        } else {
-                            payload = buffer+llen+3+tl;
-                            callback(topic,payload,len-llen-3-tl);
+                    uint16_t tl = (rxBuffer[llen+1]<<8)+rxBuffer[llen+2]; /* topic length in bytes */
+                    uint16_t offset = llen+3+tl;
+                    uint8_t qos = (rxBuffer[0]&0x06)>>1;
+                    if ((uint32_t)llen+3+tl+(qos > 0 ? 2 : 0) > len) {
+                        // Topic (and msgId) longer than the packet - kill the connection
+                        _state = MQTT_DISCONNECTED;
+                        _client->stop();
+                        return false;
+                    }
+                    if (qos > 0) {
+                        msgId = (rxBuffer[offset]<<8)+rxBuffer[offset+1];
+                        offset += 2;
+                    }
+                    if (protocolVersion == MQTT_VERSION_5) {
+                        offset = skipProperties(offset,len);
+                    }
+                    uint32_t matched = 0;
+                    if (chunked) {
+                        // Already passed to chunkCallback
+                    } else if (filterCount > 0 && (matched = matchFilters(0,(const char*)rxBuffer+llen+3,tl,0)) != 0) {
+                        for (uint8_t i = 0;i<filterCount;i++) {
+                            if (matched & (1UL << i)) {
+                                filters[i].filterCallback((const char*)rxBuffer+llen+3,tl,rxBuffer+offset,len-offset,msgId,qos,rxBuffer[0]&1);
+                            }
                         }
+                    } else if (viewCallback) {
+                        // Topic and payload handed out where they are in the buffer - no copy
+                        viewCallback((const char*)rxBuffer+llen+3,tl,rxBuffer+offset,len-offset,msgId,qos,rxBuffer[0]&1);
+                    } else if (callback) {
+                        memmove(rxBuffer+llen+2,rxBuffer+llen+3,tl); /* move topic inside buffer 1 byte to front */
+                        rxBuffer[llen+2+tl] = 0; /* end the topic as a 'C' string with \x00 */
+                        char *topic = (char*) rxBuffer+llen+2;
+                        payload = rxBuffer+offset;
+                        callback(topic,payload,len-offset);
+                    }
+                    if (qos == 1 && (chunked || matched || viewCallback || callback)) {
+                        buffer[0] = MQTTPUBACK;
+                        buffer[1] = 2;
+                        buffer[2] = (msgId >> 8);
+                        buffer[3] = (msgId & 0xFF);
+                        _client->write(buffer,4);
+                        lastOutActivity = t;
+                    }
+                } else if (type == MQTTPUBACK && len >= llen+3) {
+                    msgId = (rxBuffer[llen+1]<<8)+rxBuffer[llen+2];
+                    for (uint8_t i = 0;i<MQTT_MAX_INFLIGHT;i++) {
+                        if (inflight[i].msgId == msgId) {
+                            inflight[i].msgId = 0;
+                        }
+                    }
+                } else if (type == MQTTSUBACK) {
+                    if (subscribesPending > 0) {
+                        subscribesPending--;
+                    }
+                    // One return code per filter after the msgId (and the properties), 0x80 and up is a failure
+                    uint16_t i = llen+3;
+                    boolean refused = false;
+                    if (protocolVersion == MQTT_VERSION_5) {
+                        i = skipProperties(i,len);
+                    }
+                    for (;i<len;i++) {
+                        if (rxBuffer[i] >= 0x80) {
+                            subscribesRefused++;
+                            refused = true;
+                        }
+                    }
+                    if (refused && disconnectOnRefused) {
+                        _state = MQTT_SUBSCRIBE_REFUSED;
+                        _client->stop();
+                        return false;
                     }
                 } else if (type == MQTTPINGREQ) {
                     buffer[0] = MQTTPINGRESP;
@@ -378,14 +727,18 @@ boolean PubSubClient::publish(const char* topic, const uint8_t* payload, unsigne
 }
 
 boolean PubSubClient::publish(const char* topic, const uint8_t* payload, unsigned int plength, boolean retained) {
+    if (!connected() && queueEnabled) {
+        MQTTSegment segment = {payload, plength};
+        return enqueue(topic, &segment, 1, retained, 0);
+    }
     if (connected()) {
-        if (MQTT_MAX_PACKET_SIZE < MQTT_MAX_HEADER_SIZE + 2+strlen(topic) + plength) {
+        if (this->bufferSize < MQTT_MAX_HEADER_SIZE + 2+strlen(topic) + propertiesSize() + plength) {
             // Too long
             return false;
         }
         // Leave room in the buffer for header and variable length field
         uint16_t length = MQTT_MAX_HEADER_SIZE;
-        length = writeString(topic,buffer,length);
+        length = writePublishTopic(topic,0,true,length);
         uint16_t i;
         for (i=0;i<plength;i++) {
             buffer[length++] = payload[i];
@@ -399,60 +752,160 @@ boolean PubSubClient::publish(const char* topic, const uint8_t* payload, unsigne
     return false;
 }
 
-boolean PubSubClient::publish_P(const char* topic, const char* payload, boolean retained) {
-    return publish_P(topic, (const uint8_t*)payload, strlen(payload), retained);
+boolean PubSubClient::publish(const char* topic, const uint8_t* payload, unsigned int plength, boolean retained, uint8_t qos) {
+    if (qos == 0) {
+        return publish(topic, payload, plength, retained);
+    }
+    MQTTSegment segment = {payload, plength};
+    return publishv(topic, &segment, 1, retained, qos);
 }
 
-boolean PubSubClient::publish_P(const char* topic, const uint8_t* payload, unsigned int plength, boolean retained) {
-    uint8_t llen = 0;
-    uint8_t digit;
-    unsigned int rc = 0;
-    uint16_t tlen;
-    unsigned int pos = 0;
-    unsigned int i;
-    uint8_t header;
-    unsigned int len;
+boolean PubSubClient::publishv(const char* topic, const MQTTSegment* segments, uint8_t count, boolean retained) {
+    return publishv(topic, segments, count, retained, 0);
+}
 
+boolean PubSubClient::publishv(const char* topic, const MQTTSegment* segments, uint8_t count, boolean retained, uint8_t qos) {
+    if (qos > 1) {
+        return false;
+    }
     if (!connected()) {
+        return queueEnabled && enqueue(topic, segments, count, retained, qos);
+    }
+    uint32_t plength = 0;
+    for (uint8_t i = 0;i<count;i++) {
+        plength += segments[i].length;
+    }
+    if (this->bufferSize < MQTT_MAX_HEADER_SIZE + 2+strlen(topic) + 2 + propertiesSize()) {
+        // Too long
         return false;
     }
-
-    tlen = strlen(topic);
-
-    header = MQTTPUBLISH;
+    uint8_t header = MQTTPUBLISH;
     if (retained) {
         header |= 1;
     }
-    buffer[pos++] = header;
-    len = plength + 2 + tlen;
-    do {
-        digit = len % 128;
-        len = len / 128;
-        if (len > 0) {
-            digit |= 0x80;
+    MQTTInflight* slot = NULL;
+    if (qos == 1 && inflightCount() < inflightLimit()) {
+        for (uint8_t i = 0;i<inflightWindow;i++) {
+            if (inflight[i].msgId == 0) {
+                slot = &inflight[i];
+                break;
+            }
         }
-        buffer[pos++] = digit;
-        llen++;
-    } while(len>0);
+    }
+    if (qos == 1) {
+        if (slot == NULL) {
+            // Window full
+            return false;
+        }
+        header |= MQTTQOS1;
+    }
+    // Leave room in the buffer for header and variable length field
+    uint16_t length = MQTT_MAX_HEADER_SIZE;
+    if (qos == 0) {
+        length = writePublishTopic(topic,0,true,length);
+        size_t hlen = buildHeader(header, buffer, length-MQTT_MAX_HEADER_SIZE+plength);
+        size_t rc = _client->write(buffer+(MQTT_MAX_HEADER_SIZE-hlen),hlen+length-MQTT_MAX_HEADER_SIZE);
+        for (uint8_t i = 0;i<count;i++) {
+            if (segments[i].length > 0) {
+                rc += _client->write(segments[i].data,segments[i].length);
+            }
+        }
+        lastOutActivity = now();
+        return rc == hlen+length-MQTT_MAX_HEADER_SIZE+plength;
+    }
 
-    pos = writeString(topic,buffer,pos);
+    // Size checked before a msgId is taken, the id is filled in after it
+    length = writePublishTopic(topic,0xFFFF,false,MQTT_MAX_HEADER_SIZE);
+    size_t hlen = buildHeader(header, buffer, length-MQTT_MAX_HEADER_SIZE+plength);
+    size_t total = hlen+length-MQTT_MAX_HEADER_SIZE+plength;
+    if (total > MQTT_INFLIGHT_PACKET_SIZE) {
+        return false;
+    }
+    uint16_t msgId = nextPacketId();
+    size_t idPos = MQTT_MAX_HEADER_SIZE+2+strlen(topic);
+    buffer[idPos] = (msgId >> 8);
+    buffer[idPos+1] = (msgId & 0xFF);
+    // Put together in the slot it is resent from
+    size_t pos = hlen+length-MQTT_MAX_HEADER_SIZE;
+    memcpy(slot->packet,buffer+(MQTT_MAX_HEADER_SIZE-hlen),pos);
+    size_t start = pos;
+    for (uint8_t i = 0;i<count;i++) {
+        memcpy(slot->packet+pos,segments[i].data,segments[i].length);
+        pos += segments[i].length;
+    }
+    size_t rc;
+    size_t expected;
+    if (protocolVersion == MQTT_VERSION_5 && serverAliasMax > 0) {
+        // Sent with the topic alias, the slot keeps the full topic - aliases don't survive a reconnect
+        length = writePublishTopic(topic,msgId,true,MQTT_MAX_HEADER_SIZE);
+        hlen = buildHeader(header, buffer, length-MQTT_MAX_HEADER_SIZE+plength);
+        expected = hlen+length-MQTT_MAX_HEADER_SIZE+plength;
+        rc = _client->write(buffer+(MQTT_MAX_HEADER_SIZE-hlen),hlen+length-MQTT_MAX_HEADER_SIZE);
+        if (plength > 0) {
+            rc += _client->write(slot->packet+start,plength);
+        }
+    } else {
+        expected = total;
+        rc = _client->write(slot->packet,total);
+    }
+    lastOutActivity = now();
+    if (rc != expected) {
+        return false;
+    }
+    slot->msgId = msgId;
+    slot->length = total;
+    return true;
+}
 
-    rc += _client->write(buffer,pos);
+boolean PubSubClient::publish_P(const char* topic, const char* payload, boolean retained) {
+    return publish_P(topic, (const uint8_t*)payload, strlen_P(payload), retained);
+}
 
-    for (i=0;i<plength;i++) {
-        rc += _client->write((char)pgm_read_byte_near(payload + i));
+boolean PubSubClient::publish_P(const char* topic, const uint8_t* payload, unsigned int plength, boolean retained) {
+    if (!connected()) {
+        return false;
+    }
+    if (this->bufferSize < MQTT_MAX_HEADER_SIZE + 2+strlen(topic) + propertiesSize()) {
+        // Too long
+        return false;
+    }
+    // Leave room in the buffer for header and variable length field
+    uint16_t length = MQTT_MAX_HEADER_SIZE;
+    length = writePublishTopic(topic,0,true,length);
+    uint8_t header = MQTTPUBLISH;
+    if (retained) {
+        header |= 1;
+    }
+    size_t hlen = buildHeader(header, buffer, plength+length-MQTT_MAX_HEADER_SIZE);
+
+    // The payload is copied from flash behind the topic - the whole buffer goes out in one write
+    uint8_t* from = buffer+(MQTT_MAX_HEADER_SIZE-hlen);
+    uint16_t pos = length;
+    unsigned int i = 0;
+    size_t rc = 0;
+    while (true) {
+        uint16_t n = (plength-i < (unsigned int)(bufferSize-pos)) ? plength-i : bufferSize-pos;
+        memcpy_P(buffer+pos,payload+i,n);
+        pos += n;
+        i += n;
+        rc += _client->write(from,buffer+pos-from);
+        if (i >= plength) {
+            break;
+        }
+        from = buffer;
+        pos = 0;
     }
 
-    lastOutActivity = millis();
+    lastOutActivity = now();
 
-    return rc == tlen + 4 + plength;
+    return rc == hlen+length-MQTT_MAX_HEADER_SIZE+plength;
 }
 
 boolean PubSubClient::beginPublish(const char* topic, unsigned int plength, boolean retained) {
     if (connected()) {
         // Send the header and variable length field
         uint16_t length = MQTT_MAX_HEADER_SIZE;
-        length = writeString(topic,buffer,length);
+        length = writePublishTopic(topic,0,true,length);
         uint16_t i;
         uint8_t header = MQTTPUBLISH;
         if (retained) {
@@ -460,7 +913,7 @@ boolean PubSubClient::beginPublish(const char* topic, unsigned int plength, bool
         }
         size_t hlen = buildHeader(header, buffer, plength+length-MQTT_MAX_HEADER_SIZE);
         uint16_t rc = _client->write(buffer+(MQTT_MAX_HEADER_SIZE-hlen),length-(MQTT_MAX_HEADER_SIZE-hlen));
-        lastOutActivity = millis();
+        lastOutActivity = now();
         return (rc == (length-(MQTT_MAX_HEADER_SIZE-hlen)));
     }
     return false;
@@ -471,21 +924,21 @@ int PubSubClient::endPublish() {
 }
 
 size_t PubSubClient::write(uint8_t data) {
-    lastOutActivity = millis();
+    lastOutActivity = now();
     return _client->write(data);
 }
 
 size_t PubSubClient::write(const uint8_t *buffer, size_t size) {
-    lastOutActivity = millis();
+    lastOutActivity = now();
     return _client->write(buffer,size);
 }
 
-size_t PubSubClient::buildHeader(uint8_t header, uint8_t* buf, uint16_t length) {
+size_t PubSubClient::buildHeader(uint8_t header, uint8_t* buf, uint32_t length) {
     uint8_t lenBuf[4];
     uint8_t llen = 0;
     uint8_t digit;
     uint8_t pos = 0;
-    uint16_t len = length;
+    uint32_t len = length;
     do {
         digit = len % 128;
         len = len / 128;
@@ -522,7 +975,7 @@ boolean PubSubClient::write(uint8_t header, uint8_t* buf, uint16_t length) {
     return result;
 #else
     rc = _client->write(buf+(MQTT_MAX_HEADER_SIZE-hlen),length+hlen);
-    lastOutActivity = millis();
+    lastOutActivity = now();
     return (rc == hlen+length);
 #endif
 }
@@ -532,42 +985,60 @@ boolean PubSubClient::subscribe(const char* topic) {
 }
 
 boolean PubSubClient::subscribe(const char* topic, uint8_t qos) {
-    if (qos > 1) {
-        return false;
+    return subscribe(&topic, &qos, 1);
+}
+
+boolean PubSubClient::subscribe(const char* const* topics, const uint8_t* qos, size_t n) {
+    for (size_t i = 0;i<n;i++) {
+        if (qos != NULL && qos[i] > 1) {
+            return false;
+        }
+        if (this->bufferSize < 10 + strlen(topics[i]) + (protocolVersion == MQTT_VERSION_5)) {
+            // Too long
+            return false;
+        }
     }
-    if (MQTT_MAX_PACKET_SIZE < 9 + strlen(topic)) {
-        // Too long
+    if (!connected()) {
         return false;
     }
-    if (connected()) {
+    size_t i = 0;
+    while (i < n) {
         // Leave room in the buffer for header and variable length field
         uint16_t length = MQTT_MAX_HEADER_SIZE;
-        nextMsgId++;
-        if (nextMsgId == 0) {
-            nextMsgId = 1;
+        uint16_t msgId = nextPacketId();
+        buffer[length++] = (msgId >> 8);
+        buffer[length++] = (msgId & 0xFF);
+        if (protocolVersion == MQTT_VERSION_5) {
+            // No subscription identifier or user properties
+            buffer[length++] = 0;
         }
-        buffer[length++] = (nextMsgId >> 8);
-        buffer[length++] = (nextMsgId & 0xFF);
-        length = writeString((char*)topic, buffer,length);
-        buffer[length++] = qos;
-        return write(MQTTSUBSCRIBE|MQTTQOS1,buffer,length-MQTT_MAX_HEADER_SIZE);
+        // As many filters as fit, the rest goes into the next packet
+        do {
+            length = writeString(topics[i], buffer,length);
+            buffer[length++] = (qos != NULL) ? qos[i] : 0;
+            i++;
+        } while (i < n && length + 3 + strlen(topics[i]) <= this->bufferSize);
+        if (!write(MQTTSUBSCRIBE|MQTTQOS1,buffer,length-MQTT_MAX_HEADER_SIZE)) {
+            return false;
+        }
+        subscribesPending++;
     }
-    return false;
+    return true;
 }
 
 boolean PubSubClient::unsubscribe(const char* topic) {
-    if (MQTT_MAX_PACKET_SIZE < 9 + strlen(topic)) {
+    if (this->bufferSize < 9 + strlen(topic) + (protocolVersion == MQTT_VERSION_5)) {
         // Too long
         return false;
     }
     if (connected()) {
         uint16_t length = MQTT_MAX_HEADER_SIZE;
-        nextMsgId++;
-        if (nextMsgId == 0) {
-            nextMsgId = 1;
+        uint16_t msgId = nextPacketId();
+        buffer[length++] = (msgId >> 8);
+        buffer[length++] = (msgId & 0xFF);
+        if (protocolVersion == MQTT_VERSION_5) {
+            buffer[length++] = 0;
         }
-        buffer[length++] = (nextMsgId >> 8);
-        buffer[length++] = (nextMsgId & 0xFF);
         length = writeString(topic, buffer,length);
         return write(MQTTUNSUBSCRIBE|MQTTQOS1,buffer,length-MQTT_MAX_HEADER_SIZE);
     }
@@ -581,7 +1052,471 @@ void PubSubClient::disconnect() {
     _state = MQTT_DISCONNECTED;
     _client->flush();
     _client->stop();
-    lastInActivity = lastOutActivity = millis();
+    lastInActivity = lastOutActivity = now();
+}
+
+// Next message id - never 0 and never one that is still in flight
+uint16_t PubSubClient::nextPacketId() {
+    boolean used;
+    do {
+        nextMsgId++;
+        if (nextMsgId == 0) {
+            nextMsgId = 1;
+        }
+        used = false;
+        for (uint8_t i = 0;i<MQTT_MAX_INFLIGHT;i++) {
+            if (inflight[i].msgId == nextMsgId) {
+                used = true;
+            }
+        }
+    } while (used);
+    return nextMsgId;
+}
+
+void PubSubClient::initInflight() {
+    for (uint8_t i = 0;i<MQTT_MAX_INFLIGHT;i++) {
+        inflight[i].msgId = 0;
+    }
+    inflightWindow = MQTT_MAX_INFLIGHT;
+    subscribesPending = 0;
+    subscribesRefused = 0;
+    disconnectOnRefused = false;
+}
+
+// Messages not acknowledged before the connection was lost - sent again with DUP
+void PubSubClient::resendInflight() {
+    for (uint8_t i = 0;i<MQTT_MAX_INFLIGHT;i++) {
+        if (inflight[i].msgId != 0) {
+            inflight[i].packet[0] |= MQTTDUP;
+            _client->write(inflight[i].packet,inflight[i].length);
+            lastOutActivity = now();
+        }
+    }
+}
+
+void PubSubClient::initQueue() {
+    queueHead = 0;
+    queueCount = 0;
+    queueEnabled = false;
+    queueQueued = 0;
+    queueDropped = 0;
+    queueCoalesced = 0;
+}
+
+boolean PubSubClient::enqueue(const char* topic, const MQTTSegment* segments, uint8_t count, boolean retained, uint8_t qos) {
+    size_t tlen = strlen(topic)+1;
+    size_t plength = 0;
+    for (uint8_t i = 0;i<count;i++) {
+        plength += segments[i].length;
+    }
+    if (tlen+plength > MQTT_QUEUE_ENTRY_SIZE) {
+        queueDropped++;
+        return false;
+    }
+    MQTTQueued* entry = NULL;
+    for (uint8_t i = 0;i<queueCount;i++) {
+        MQTTQueued* e = &queue[(queueHead+i)%MQTT_QUEUE_LENGTH];
+        if (strcmp((const char*)e->data,topic) == 0) {
+            entry = e;
+            queueCoalesced++;
+            break;
+        }
+    }
+    if (entry == NULL) {
+        if (queueCount == MQTT_QUEUE_LENGTH) {
+            // Full - the oldest one goes
+            queueHead = (queueHead+1)%MQTT_QUEUE_LENGTH;
+            queueCount--;
+            queueDropped++;
+        }
+        entry = &queue[(queueHead+queueCount)%MQTT_QUEUE_LENGTH];
+        queueCount++;
+    }
+    memcpy(entry->data,topic,tlen);
+    size_t pos = tlen;
+    for (uint8_t i = 0;i<count;i++) {
+        memcpy(entry->data+pos,segments[i].data,segments[i].length);
+        pos += segments[i].length;
+    }
+    entry->length = tlen+plength;
+    entry->qos = qos;
+    entry->retained = retained;
+    queueQueued++;
+    return true;
+}
+
+// Oldest first, stops when a message can't be sent now (connection lost, in-flight window full)
+void PubSubClient::flushQueue() {
+    boolean enabled = queueEnabled;
+    queueEnabled = false;  // a failed publish must not queue the message again
+    while (queueCount > 0 && connected()) {
+        MQTTQueued* e = &queue[queueHead];
+        size_t tlen = strlen((const char*)e->data)+1;
+        if (!publish((const char*)e->data,e->data+tlen,e->length-tlen,e->retained,e->qos)) {
+            if (!connected() || (e->qos > 0 && inflightCount() >= inflightLimit())) {
+                break;
+            }
+            // Can't be sent at all
+            queueDropped++;
+        }
+        queueHead = (queueHead+1)%MQTT_QUEUE_LENGTH;
+        queueCount--;
+    }
+    queueEnabled = enabled;
+}
+
+PubSubClient& PubSubClient::setOfflineQueue(boolean enabled) {
+    this->queueEnabled = enabled;
+    return *this;
+}
+
+uint8_t PubSubClient::offlinePending() {
+    return this->queueCount;
+}
+
+uint32_t PubSubClient::offlineQueued() {
+    return this->queueQueued;
+}
+
+uint32_t PubSubClient::offlineDropped() {
+    return this->queueDropped;
+}
+
+uint32_t PubSubClient::offlineCoalesced() {
+    return this->queueCoalesced;
+}
+
+PubSubClient& PubSubClient::setInflightWindow(uint8_t size) {
+    if (size < 1) {
+        size = 1;
+    }
+    if (size > MQTT_MAX_INFLIGHT) {
+        size = MQTT_MAX_INFLIGHT;
+    }
+    this->inflightWindow = size;
+    return *this;
+}
+
+uint8_t PubSubClient::inflightCount() {
+    uint8_t count = 0;
+    for (uint8_t i = 0;i<MQTT_MAX_INFLIGHT;i++) {
+        if (inflight[i].msgId != 0) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void PubSubClient::initBuffers() {
+    this->buffer = NULL;
+    this->rxBuffer = NULL;
+    this->bufferSize = 0;
+    this->rxBufferSize = 0;
+    this->buffersOwned = false;
+    this->chunked = false;
+    this->rxDropped = 0;
+    this->chunkCallback = NULL;
+    setBufferSize(MQTT_MAX_PACKET_SIZE);
+}
+
+void PubSubClient::freeBuffers() {
+    if (this->buffersOwned) {
+        if (this->rxBuffer != this->buffer) {
+            free(this->rxBuffer);
+        }
+        free(this->buffer);
+    }
+    this->buffer = NULL;
+    this->rxBuffer = NULL;
+    this->buffersOwned = false;
+}
+
+boolean PubSubClient::setBufferSize(uint16_t size) {
+    if (size < MQTT_MIN_BUFFER_SIZE) {
+        return false;
+    }
+    uint8_t* buf = (uint8_t*)malloc(size);
+    if (buf == NULL) {
+        return false;
+    }
+    freeBuffers();
+    this->buffer = this->rxBuffer = buf;
+    this->bufferSize = this->rxBufferSize = size;
+    this->buffersOwned = true;
+    return true;
+}
+
+boolean PubSubClient::setBufferSize(uint16_t rxSize, uint16_t txSize) {
+    if (rxSize < MQTT_MIN_BUFFER_SIZE || txSize < MQTT_MIN_BUFFER_SIZE) {
+        return false;
+    }
+    uint8_t* rx = (uint8_t*)malloc(rxSize);
+    uint8_t* tx = (rx == NULL) ? NULL : (uint8_t*)malloc(txSize);
+    if (tx == NULL) {
+        free(rx);
+        return false;
+    }
+    freeBuffers();
+    this->rxBuffer = rx;
+    this->rxBufferSize = rxSize;
+    this->buffer = tx;
+    this->bufferSize = txSize;
+    this->buffersOwned = true;
+    return true;
+}
+
+PubSubClient& PubSubClient::setBuffer(uint8_t* buf, uint16_t size) {
+    return setBuffer(buf,size,buf,size);
+}
+
+PubSubClient& PubSubClient::setBuffer(uint8_t* rxBuf, uint16_t rxSize, uint8_t* txBuf, uint16_t txSize) {
+    freeBuffers();
+    this->rxBuffer = rxBuf;
+    this->rxBufferSize = rxSize;
+    this->buffer = txBuf;
+    this->bufferSize = txSize;
+    return *this;
+}
+
+uint16_t PubSubClient::getBufferSize() {
+    return this->bufferSize;
+}
+
+uint16_t PubSubClient::getRxBufferSize() {
+    return this->rxBufferSize;
+}
+
+uint32_t PubSubClient::rxDroppedCount() {
+    return this->rxDropped;
+}
+
+uint8_t PubSubClient::subscribePending() {
+    return this->subscribesPending;
+}
+
+uint32_t PubSubClient::subscribeRefused() {
+    return this->subscribesRefused;
+}
+
+PubSubClient& PubSubClient::setDisconnectOnRefused(boolean enabled) {
+    this->disconnectOnRefused = enabled;
+    return *this;
+}
+
+void PubSubClient::initProtocol() {
+    this->keepAlive = MQTT_KEEPALIVE;
+    this->socketTimeout = MQTT_SOCKET_TIMEOUT;
+    this->clock = NULL;
+    this->protocolVersion = MQTT_VERSION;
+    this->sessionExpiry = 0;
+    this->sessionPresentFlag = false;
+    this->serverReceiveMax = 0xFFFF;
+    this->serverAliasMax = 0;
+    for (uint8_t i = 0;i<MQTT_TOPIC_ALIASES;i++) {
+        this->aliases[i][0] = 0;
+    }
+}
+
+PubSubClient& PubSubClient::setKeepAlive(uint16_t keepAlive) {
+    this->keepAlive = keepAlive;
+    return *this;
+}
+
+PubSubClient& PubSubClient::setSocketTimeout(uint16_t timeout) {
+    this->socketTimeout = timeout;
+    return *this;
+}
+
+PubSubClient& PubSubClient::setClock(MQTT_CLOCK_SIGNATURE) {
+    this->clock = clock;
+    return *this;
+}
+
+unsigned long PubSubClient::now() {
+    if (this->clock) {
+        return this->clock();
+    }
+    return millis();
+}
+
+unsigned long PubSubClient::nextKeepAlive() {
+    if (this->keepAlive == 0 || !connected()) {
+        return ULONG_MAX;
+    }
+    unsigned long interval = this->keepAlive*1000UL;
+    // Same checks as in loop(), which acts once the interval is exceeded
+    unsigned long since = now() - (pingOutstanding ? lastInActivity : lastOutActivity);
+    if (since > interval) {
+        return 0;
+    }
+    return interval - since + 1;
+}
+
+PubSubClient& PubSubClient::setProtocolVersion(uint8_t version) {
+    this->protocolVersion = version;
+    return *this;
+}
+
+PubSubClient& PubSubClient::setSessionExpiry(uint32_t seconds) {
+    this->sessionExpiry = seconds;
+    return *this;
+}
+
+boolean PubSubClient::sessionPresent() {
+    return this->sessionPresentFlag;
+}
+
+uint8_t PubSubClient::inflightLimit() {
+    if (this->serverReceiveMax < this->inflightWindow) {
+        return this->serverReceiveMax;
+    }
+    return this->inflightWindow;
+}
+
+uint8_t PubSubClient::propertiesSize() {
+    // Room for the properties of a PUBLISH: length and topic alias
+    return (this->protocolVersion == MQTT_VERSION_5) ? 4 : 0;
+}
+
+uint16_t PubSubClient::topicAlias(const char* topic, boolean* known) {
+    *known = false;
+    uint16_t count = (this->serverAliasMax < MQTT_TOPIC_ALIASES) ? this->serverAliasMax : MQTT_TOPIC_ALIASES;
+    if (strlen(topic) >= MQTT_TOPIC_ALIAS_SIZE) {
+        return 0;
+    }
+    for (uint16_t i = 0;i<count;i++) {
+        if (aliases[i][0] == 0) {
+            // First time - sent with the topic, the alias is set up with it
+            strcpy(aliases[i],topic);
+            return i+1;
+        }
+        if (strcmp(aliases[i],topic) == 0) {
+            *known = true;
+            return i+1;
+        }
+    }
+    return 0;
+}
+
+uint16_t PubSubClient::writePublishTopic(const char* topic, uint16_t msgId, boolean alias, uint16_t pos) {
+    uint16_t id = 0;
+    boolean known = false;
+    if (alias && this->protocolVersion == MQTT_VERSION_5) {
+        id = topicAlias(topic,&known);
+    }
+    pos = writeString(known ? "" : topic,buffer,pos);
+    if (msgId != 0) {
+        buffer[pos++] = (msgId >> 8);
+        buffer[pos++] = (msgId & 0xFF);
+    }
+    if (this->protocolVersion == MQTT_VERSION_5) {
+        if (id != 0) {
+            buffer[pos++] = 3;
+            buffer[pos++] = 0x23;
+            buffer[pos++] = (id >> 8);
+            buffer[pos++] = (id & 0xFF);
+        } else {
+            buffer[pos++] = 0;
+        }
+    }
+    return pos;
+}
+
+uint16_t PubSubClient::skipProperties(uint16_t pos, uint16_t end) {
+    uint32_t length = 0;
+    uint32_t multiplier = 1;
+    uint8_t digit;
+    do {
+        if (pos >= end) {
+            return end;
+        }
+        digit = rxBuffer[pos++];
+        length += (digit & 127) * multiplier;
+        multiplier <<= 7;
+    } while ((digit & 128) != 0 && multiplier <= (1UL<<21));
+    if (length > (uint32_t)(end-pos)) {
+        return end;
+    }
+    return pos+length;
+}
+
+void PubSubClient::readConnackProperties(uint16_t pos, uint16_t end) {
+    end = skipProperties(pos,end);
+    // Step over the properties length
+    while (pos < end && (rxBuffer[pos] & 128)) {
+        pos++;
+    }
+    pos++;
+    while (pos < end) {
+        uint8_t id = rxBuffer[pos++];
+        switch (id) {
+            case 0x21:  // receive maximum
+                if (pos+2 > end) {
+                    return;
+                }
+                this->serverReceiveMax = (rxBuffer[pos]<<8)+rxBuffer[pos+1];
+                if (this->serverReceiveMax == 0) {
+                    this->serverReceiveMax = 0xFFFF;
+                }
+                pos += 2;
+                break;
+            case 0x22:  // topic alias maximum
+                if (pos+2 > end) {
+                    return;
+                }
+                this->serverAliasMax = (rxBuffer[pos]<<8)+rxBuffer[pos+1];
+                pos += 2;
+                break;
+            case 0x13:
+            case 0x23:
+                pos += 2;
+                break;
+            case 0x02:
+            case 0x11:
+            case 0x18:
+            case 0x27:
+                pos += 4;
+                break;
+            case 0x0B:
+                while (pos < end && (rxBuffer[pos] & 128)) {
+                    pos++;
+                }
+                pos++;
+                break;
+            case 0x03:
+            case 0x08:
+            case 0x09:
+            case 0x12:
+            case 0x15:
+            case 0x16:
+            case 0x1A:
+            case 0x1C:
+            case 0x1F:
+                if (pos+2 > end) {
+                    return;
+                }
+                pos += 2+(rxBuffer[pos]<<8)+rxBuffer[pos+1];
+                break;
+            case 0x26:  // user property, two strings
+                for (uint8_t k = 0;k<2 && pos+2 <= end;k++) {
+                    pos += 2+(rxBuffer[pos]<<8)+rxBuffer[pos+1];
+                }
+                break;
+            case 0x01:
+            case 0x17:
+            case 0x19:
+            case 0x24:
+            case 0x25:
+            case 0x28:
+            case 0x29:
+            case 0x2A:
+                pos += 1;
+                break;
+            default:
+                // Unknown property, its size can't be known
+                return;
+        }
+    }
 }
 
 uint16_t PubSubClient::writeString(const char* string, uint8_t* buf, uint16_t pos) {
@@ -604,6 +1539,10 @@ boolean PubSubClient::connected() {
         rc = false;
     } else {
         rc = (int)_client->connected();
+        if (rc && this->_state == MQTT_CONNECTING) {
+            // TCP is up, but no CONNACK yet
+            return false;
+        }
         if (!rc) {
             if (this->_state == MQTT_CONNECTED) {
                 this->_state = MQTT_CONNECTION_LOST;
@@ -638,6 +1577,141 @@ PubSubClient& PubSubClient::setCallback(MQTT_CALLBACK_SIGNATURE) {
     return *this;
 }
 
+PubSubClient& PubSubClient::setViewCallback(MQTT_VIEW_CALLBACK_SIGNATURE) {
+    this->viewCallback = viewCallback;
+    return *this;
+}
+
+PubSubClient& PubSubClient::setChunkCallback(MQTT_CHUNK_CALLBACK_SIGNATURE) {
+    this->chunkCallback = chunkCallback;
+    return *this;
+}
+
+boolean PubSubClient::addFilter(const char* filter, MQTT_FILTER_CALLBACK_SIGNATURE) {
+    // Check the levels and count the nodes that are not in the trie yet
+    uint8_t node = 0;
+    uint8_t needed = 0;
+    const char* level = filter;
+    while (true) {
+        const char* end = level;
+        while (*end && *end != '/') {
+            end++;
+        }
+        size_t length = end-level;
+        if (length > 255) {
+            return false;
+        }
+        for (const char* c = level;c<end;c++) {
+            // A wildcard is a level on its own, # only the last one
+            if ((*c == '+' || *c == '#') && length != 1) {
+                return false;
+            }
+            if (*c == '#' && *end) {
+                return false;
+            }
+        }
+        if (node != 0 || needed == 0) {
+            node = filterChild(node,level,length);
+        }
+        if (node == 0) {
+            needed++;
+        }
+        if (!*end) {
+            break;
+        }
+        level = end+1;
+    }
+    if (node != 0 && filterNodes[node].filter != 0) {
+        filters[filterNodes[node].filter-1].filterCallback = filterCallback;
+        return true;
+    }
+    if (filterCount >= MQTT_MAX_FILTERS || filterNodeCount+needed > MQTT_FILTER_NODES) {
+        return false;
+    }
+    // Add the missing levels
+    node = 0;
+    level = filter;
+    while (true) {
+        const char* end = level;
+        while (*end && *end != '/') {
+            end++;
+        }
+        uint8_t child = filterChild(node,level,end-level);
+        if (child == 0) {
+            child = filterNodeCount++;
+            filterNodes[child].token = level;
+            filterNodes[child].length = end-level;
+            filterNodes[child].child = 0;
+            filterNodes[child].filter = 0;
+            filterNodes[child].sibling = filterNodes[node].child;
+            filterNodes[node].child = child;
+        }
+        node = child;
+        if (!*end) {
+            break;
+        }
+        level = end+1;
+    }
+    filters[filterCount].filterCallback = filterCallback;
+    filterNodes[node].filter = ++filterCount;
+    return true;
+}
+
+void PubSubClient::clearFilters() {
+    filterNodes[0].child = 0;
+    filterNodes[0].filter = 0;
+    filterNodeCount = 1;
+    filterCount = 0;
+}
+
+uint8_t PubSubClient::filterChild(uint8_t node, const char* token, uint8_t length) {
+    for (uint8_t c = filterNodes[node].child;c != 0;c = filterNodes[c].sibling) {
+        if (filterNodes[c].length == length && memcmp(filterNodes[c].token,token,length) == 0) {
+            return c;
+        }
+    }
+    return 0;
+}
+
+// Filters below node matching the topic from pos on (bit i = filter i), pos is past the end
+// when all levels of the topic are used up
+uint32_t PubSubClient::matchFilters(uint8_t node, const char* topic, size_t topicLen, size_t pos) {
+    uint32_t matched = 0;
+    size_t end = pos;
+    while (end < topicLen && topic[end] != '/') {
+        end++;
+    }
+    // Wildcards in the first level don't match topics starting with $
+    boolean system = (node == 0 && topicLen > 0 && topic[0] == '$');
+    for (uint8_t c = filterNodes[node].child;c != 0;c = filterNodes[c].sibling) {
+        MQTTFilterNode* n = &filterNodes[c];
+        boolean wildcard = (n->length == 1 && (n->token[0] == '+' || n->token[0] == '#'));
+        if (wildcard && system) {
+            continue;
+        }
+        if (wildcard && n->token[0] == '#') {
+            // The rest of the topic, also none ("a/#" matches "a")
+            matched |= 1UL << (n->filter-1);
+            continue;
+        }
+        if (pos > topicLen) {
+            continue;
+        }
+        if (!wildcard && (n->length != end-pos || memcmp(n->token,topic+pos,end-pos) != 0)) {
+            continue;
+        }
+        if (end >= topicLen) {
+            if (n->filter != 0) {
+                matched |= 1UL << (n->filter-1);
+            }
+            matched |= matchFilters(c,topic,topicLen,topicLen+1);
+        } else {
+            matched |= matchFilters(c,topic,topicLen,end+1);
+        }
+    }
+    return matched;
+}
+
 PubSubClient& PubSubClient::setClient(Client& client){
     this->_client = &client;
     return *this;
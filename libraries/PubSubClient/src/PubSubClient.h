@@ -14,6 +14,7 @@
 
 #define MQTT_VERSION_3_1      3
 #define MQTT_VERSION_3_1_1    4
+#define MQTT_VERSION_5        5   // only at runtime with setProtocolVersion
 
 // MQTT_VERSION : Pick the version
 //#define MQTT_VERSION MQTT_VERSION_3_1
@@ -21,27 +22,69 @@
 #define MQTT_VERSION MQTT_VERSION_3_1_1
 #endif
 
-// MQTT_MAX_PACKET_SIZE : Maximum packet size
+// MQTT_MAX_PACKET_SIZE : Default size of the packet buffer (can be changed with setBufferSize)
 #ifndef MQTT_MAX_PACKET_SIZE
 #define MQTT_MAX_PACKET_SIZE 1000
 #endif
 
-// MQTT_KEEPALIVE : keepAlive interval in Seconds
+// MQTT_KEEPALIVE : keepAlive interval in Seconds (default, setKeepAlive at runtime)
 #ifndef MQTT_KEEPALIVE
 #define MQTT_KEEPALIVE 15
 #endif
 
-// MQTT_SOCKET_TIMEOUT: socket timeout interval in Seconds
+// MQTT_SOCKET_TIMEOUT: socket timeout interval in Seconds (default, setSocketTimeout at runtime)
 #ifndef MQTT_SOCKET_TIMEOUT
 #define MQTT_SOCKET_TIMEOUT 15
 #endif
 
+// MQTT_MAX_INFLIGHT : QoS 1 messages kept until PUBACK (the window can be made smaller with setInflightWindow)
+#ifndef MQTT_MAX_INFLIGHT
+#define MQTT_MAX_INFLIGHT 4
+#endif
+
+// MQTT_INFLIGHT_PACKET_SIZE : longest QoS 1 PUBLISH (whole packet) that can be kept for retransmission
+#ifndef MQTT_INFLIGHT_PACKET_SIZE
+#define MQTT_INFLIGHT_PACKET_SIZE 256
+#endif
+
+// MQTT_QUEUE_LENGTH : messages kept while disconnected (setOfflineQueue), one per topic - newer values replace older ones
+#ifndef MQTT_QUEUE_LENGTH
+#define MQTT_QUEUE_LENGTH 8
+#endif
+
+// MQTT_QUEUE_ENTRY_SIZE : topic (with terminating 0) and payload of one queued message
+#ifndef MQTT_QUEUE_ENTRY_SIZE
+#define MQTT_QUEUE_ENTRY_SIZE 96
+#endif
+
+// MQTT_TOPIC_ALIASES : MQTT 5 topic aliases for published topics (no more than the server allows)
+#ifndef MQTT_TOPIC_ALIASES
+#define MQTT_TOPIC_ALIASES 4
+#endif
+
+// MQTT_TOPIC_ALIAS_SIZE : longest topic (with terminating 0) that gets an alias
+#ifndef MQTT_TOPIC_ALIAS_SIZE
+#define MQTT_TOPIC_ALIAS_SIZE 52
+#endif
+
+// MQTT_MAX_FILTERS : subscription filters with their own handler (addFilter), no more than 32
+#ifndef MQTT_MAX_FILTERS
+#define MQTT_MAX_FILTERS 8
+#endif
+
+// MQTT_FILTER_NODES : topic levels of all filters together, levels shared by filters count once
+#ifndef MQTT_FILTER_NODES
+#define MQTT_FILTER_NODES 24
+#endif
+
 // MQTT_MAX_TRANSFER_SIZE : limit how much data is passed to the network client
 //  in each write call. Needed for the Arduino Wifi Shield. Leave undefined to
 //  pass the entire MQTT packet in each write call.
 //#define MQTT_MAX_TRANSFER_SIZE 80
 
 // Possible values for client.state()
+#define MQTT_SUBSCRIBE_REFUSED      -6
+#define MQTT_CONNECTING             -5
 #define MQTT_CONNECTION_TIMEOUT     -4
 #define MQTT_CONNECTION_LOST        -3
 #define MQTT_CONNECT_FAILED         -2
@@ -53,6 +96,11 @@
 #define MQTT_CONNECT_BAD_CREDENTIALS 4
 #define MQTT_CONNECT_UNAUTHORIZED    5
 
+// Possible values for client.connectPoll()
+#define MQTT_POLL_FAILED      -1
+#define MQTT_POLL_IN_PROGRESS  0
+#define MQTT_POLL_CONNECTED    1
+
 #define MQTTCONNECT     1 << 4  // Client request to connect to Server
 #define MQTTCONNACK     2 << 4  // Connect Acknowledgment
 #define MQTTPUBLISH     3 << 4  // Publish message
@@ -72,38 +120,136 @@
 #define MQTTQOS0        (0 << 1)
 #define MQTTQOS1        (1 << 1)
 #define MQTTQOS2        (2 << 1)
+#define MQTTDUP         (1 << 3)
 
 // Maximum size of fixed header and variable length size header
 #define MQTT_MAX_HEADER_SIZE 5
+// Header and topic length of a received PUBLISH are always read into the buffer
+#define MQTT_MIN_BUFFER_SIZE (MQTT_MAX_HEADER_SIZE+2)
 
 #if defined(ESP8266) || defined(ESP32)
 #include <functional>
 #define MQTT_CALLBACK_SIGNATURE std::function<void(char*, uint8_t*, unsigned int)> callback
+#define MQTT_VIEW_CALLBACK_SIGNATURE std::function<void(const char*, size_t, const uint8_t*, size_t, uint16_t, uint8_t, boolean)> viewCallback
+#define MQTT_CHUNK_CALLBACK_SIGNATURE std::function<void(const char*, size_t, const uint8_t*, size_t, size_t, size_t)> chunkCallback
+#define MQTT_FILTER_CALLBACK_SIGNATURE std::function<void(const char*, size_t, const uint8_t*, size_t, uint16_t, uint8_t, boolean)> filterCallback
+#define MQTT_CLOCK_SIGNATURE std::function<unsigned long(void)> clock
 #else
 #define MQTT_CALLBACK_SIGNATURE void (*callback)(char*, uint8_t*, unsigned int)
+#define MQTT_VIEW_CALLBACK_SIGNATURE void (*viewCallback)(const char*, size_t, const uint8_t*, size_t, uint16_t, uint8_t, boolean)
+#define MQTT_CHUNK_CALLBACK_SIGNATURE void (*chunkCallback)(const char*, size_t, const uint8_t*, size_t, size_t, size_t)
+#define MQTT_FILTER_CALLBACK_SIGNATURE void (*filterCallback)(const char*, size_t, const uint8_t*, size_t, uint16_t, uint8_t, boolean)
+#define MQTT_CLOCK_SIGNATURE unsigned long (*clock)(void)
 #endif
 
-#define CHECK_STRING_LENGTH(l,s) if (l+2+strlen(s) > MQTT_MAX_PACKET_SIZE) {_client->stop();return false;}
+#define CHECK_STRING_LENGTH(l,s) if (l+2+strlen(s) > this->bufferSize) {_client->stop();return false;}
+
+// Sent QoS 1 PUBLISH waiting for PUBACK, msgId 0 = free
+struct MQTTInflight {
+   uint16_t msgId;
+   uint16_t length;
+   uint8_t packet[MQTT_INFLIGHT_PACKET_SIZE];
+};
+
+// One part of a payload sent with publishv
+struct MQTTSegment {
+   const uint8_t* data;
+   size_t length;
+};
+
+// Message published while disconnected, data = topic, 0, payload
+struct MQTTQueued {
+   uint8_t qos;
+   boolean retained;
+   uint16_t length;
+   uint8_t data[MQTT_QUEUE_ENTRY_SIZE];
+};
+
+// One topic level of the filter trie, node 0 is the root
+struct MQTTFilterNode {
+   const char* token;   // points into the filter given to addFilter
+   uint8_t length;
+   uint8_t child;       // first level below, 0 = none
+   uint8_t sibling;     // next node with the same parent, 0 = none
+   uint8_t filter;      // filter ending at this level + 1, 0 = none
+};
+
+// Handler of a filter, same arguments as the view callback
+struct MQTTFilter {
+   MQTT_FILTER_CALLBACK_SIGNATURE;
+};
 
 class PubSubClient : public Print {
 private:
    Client* _client;
-   uint8_t buffer[MQTT_MAX_PACKET_SIZE];
+   uint8_t* buffer;          // outgoing packets are built here
+   uint16_t bufferSize;
+   uint8_t* rxBuffer;        // received packets, can be the same memory as buffer
+   uint16_t rxBufferSize;
+   boolean buffersOwned;     // allocated by the client (not given with setBuffer)
+   boolean chunked;          // the last PUBLISH was passed to chunkCallback
+   uint32_t rxDropped;
    uint16_t nextMsgId;
+   MQTTInflight inflight[MQTT_MAX_INFLIGHT];
+   uint8_t inflightWindow;
+   uint8_t subscribesPending;   // SUBSCRIBE packets without SUBACK
+   uint32_t subscribesRefused;
+   boolean disconnectOnRefused;
+   uint16_t keepAlive;
+   uint16_t socketTimeout;
+   uint8_t protocolVersion;
+   uint32_t sessionExpiry;
+   boolean sessionPresentFlag;
+   uint16_t serverReceiveMax;   // MQTT 5 CONNACK, limits the in-flight window
+   uint16_t serverAliasMax;
+   char aliases[MQTT_TOPIC_ALIASES][MQTT_TOPIC_ALIAS_SIZE];  // topic of alias i+1, "" = free
+   MQTTQueued queue[MQTT_QUEUE_LENGTH];  // ring, oldest at queueHead
+   uint8_t queueHead;
+   uint8_t queueCount;
+   boolean queueEnabled;
+   uint32_t queueQueued;
+   uint32_t queueDropped;
+   uint32_t queueCoalesced;
    unsigned long lastOutActivity;
    unsigned long lastInActivity;
    bool pingOutstanding;
+   MQTT_CLOCK_SIGNATURE;
    MQTT_CALLBACK_SIGNATURE;
+   MQTT_VIEW_CALLBACK_SIGNATURE;
+   MQTT_CHUNK_CALLBACK_SIGNATURE;
+   MQTTFilterNode filterNodes[MQTT_FILTER_NODES];
+   uint8_t filterNodeCount;
+   MQTTFilter filters[MQTT_MAX_FILTERS];
+   uint8_t filterCount;
    uint16_t readPacket(uint8_t*);
    boolean readByte(uint8_t * result);
-   boolean readByte(uint8_t * result, uint16_t * index);
+   boolean readBytes(uint8_t * result, uint32_t length);
+   boolean skipBytes(uint32_t length);
    boolean write(uint8_t header, uint8_t* buf, uint16_t length);
    uint16_t writeString(const char* string, uint8_t* buf, uint16_t pos);
    // Build up the header ready to send
    // Returns the size of the header
    // Note: the header is built at the end of the first MQTT_MAX_HEADER_SIZE bytes, so will start
    //       (MQTT_MAX_HEADER_SIZE - <returned size>) bytes into the buffer
-   size_t buildHeader(uint8_t header, uint8_t* buf, uint16_t length);
+   size_t buildHeader(uint8_t header, uint8_t* buf, uint32_t length);
+   uint16_t nextPacketId();
+   void initInflight();
+   void resendInflight();
+   void initQueue();
+   void initBuffers();
+   void initProtocol();
+   unsigned long now();
+   uint8_t inflightLimit();
+   uint8_t propertiesSize();
+   uint16_t topicAlias(const char* topic, boolean* known);
+   uint16_t writePublishTopic(const char* topic, uint16_t msgId, boolean alias, uint16_t pos);
+   uint16_t skipProperties(uint16_t pos, uint16_t end);
+   void readConnackProperties(uint16_t pos, uint16_t end);
+   uint8_t filterChild(uint8_t node, const char* token, uint8_t length);
+   uint32_t matchFilters(uint8_t node, const char* topic, size_t topicLen, size_t pos);
+   void freeBuffers();
+   boolean enqueue(const char* topic, const MQTTSegment* segments, uint8_t count, boolean retained, uint8_t qos);
+   void flushQueue();
    IPAddress ip;
    const char* domain;
    uint16_t port;
@@ -124,24 +270,89 @@ public:
    PubSubClient(const char*, uint16_t, Client& client, Stream&);
    PubSubClient(const char*, uint16_t, MQTT_CALLBACK_SIGNATURE,Client& client);
    PubSubClient(const char*, uint16_t, MQTT_CALLBACK_SIGNATURE,Client& client, Stream&);
+   ~PubSubClient();
 
    PubSubClient& setServer(IPAddress ip, uint16_t port);
    PubSubClient& setServer(uint8_t * ip, uint16_t port);
    PubSubClient& setServer(const char * domain, uint16_t port);
    PubSubClient& setCallback(MQTT_CALLBACK_SIGNATURE);
+   // Used instead of the callback: (topic, topic length, payload, payload length, msgId, qos, retain).
+   // Topic and payload point into the receive buffer - the topic is not 0 terminated and both
+   // are valid only during the call
+   PubSubClient& setViewCallback(MQTT_VIEW_CALLBACK_SIGNATURE);
+   // Called for a PUBLISH that doesn't fit into the receive buffer: (topic, topic length, chunk, chunk length,
+   // offset of the chunk in the payload, payload length). The topic stays at the start of the buffer and
+   // the payload is passed through the rest of it. Without it such messages are dropped (rxDropped)
+   PubSubClient& setChunkCallback(MQTT_CHUNK_CALLBACK_SIGNATURE);
+   // Calls the handler for received messages matching the filter (with + and # wildcards), instead of
+   // the view callback or the callback, which still get the messages no filter matches. A message
+   // matching more filters goes to each of them. Adding a filter again replaces its handler.
+   // The filter is not copied and has to stay valid. Returns false if the tables are full or the
+   // filter is not valid. Only dispatches - subscribe is still needed
+   boolean addFilter(const char* filter, MQTT_FILTER_CALLBACK_SIGNATURE);
+   void clearFilters();
    PubSubClient& setClient(Client& client);
    PubSubClient& setStream(Stream& stream);
+   // Keepalive interval (seconds) sent in CONNECT, used from the next connect. 0 turns the pings off
+   PubSubClient& setKeepAlive(uint16_t keepAlive);
+   // How long (seconds) to wait for the CONNACK and for the rest of a packet
+   PubSubClient& setSocketTimeout(uint16_t timeout);
+   // Milliseconds until loop() has to run for the keepalive (ping or ping timeout), 0 = now.
+   // ULONG_MAX when not connected or without keepalive - an idle caller can sleep that long
+   unsigned long nextKeepAlive();
+   // Milliseconds for the keepalive and the timeouts, millis() by default (NULL goes back to it).
+   // Tests drive the client with a virtual clock instead of waiting
+   PubSubClient& setClock(MQTT_CLOCK_SIGNATURE);
+   // MQTT_VERSION (the default) or MQTT_VERSION_5, used from the next connect.
+   // MQTT 5 adds topic aliases for published topics, the session expiry and the server's receive maximum
+   PubSubClient& setProtocolVersion(uint8_t version);
+   // MQTT 5: how long (seconds) the server keeps the session after the connection is lost.
+   // Use with cleanSession 0 in connect, then subscriptions survive a short disconnect
+   PubSubClient& setSessionExpiry(uint32_t seconds);
+   // The server still had the session (CONNACK) - no need to subscribe again
+   boolean sessionPresent();
+   // One buffer of size bytes for both directions (MQTT_MAX_PACKET_SIZE by default).
+   // Returns 0 if there is not enough memory, the old buffer is kept then
+   boolean setBufferSize(uint16_t size);
+   // Separate buffers - rxSize limits received packets, txSize the packets that can be sent
+   boolean setBufferSize(uint16_t rxSize, uint16_t txSize);
+   // Buffers owned by the caller (e.g. static), they must live as long as the client
+   PubSubClient& setBuffer(uint8_t* buf, uint16_t size);
+   PubSubClient& setBuffer(uint8_t* rxBuf, uint16_t rxSize, uint8_t* txBuf, uint16_t txSize);
+   uint16_t getBufferSize();
+   uint16_t getRxBufferSize();
+   uint32_t rxDroppedCount();  // received packets that didn't fit into the buffer
 
    boolean connect(const char* id);
    boolean connect(const char* id, const char* user, const char* pass);
    boolean connect(const char* id, const char* willTopic, uint8_t willQos, boolean willRetain, const char* willMessage);
    boolean connect(const char* id, const char* user, const char* pass, const char* willTopic, uint8_t willQos, boolean willRetain, const char* willMessage);
    boolean connect(const char* id, const char* user, const char* pass, const char* willTopic, uint8_t willQos, boolean willRetain, const char* willMessage, boolean cleanSession);
+   // Start to connect without waiting for the server.
+   // This API:
+   //   beginConnect(...)
+   //   connectPoll() until it is not MQTT_POLL_IN_PROGRESS
+   // Sends CONNECT (the TCP connect of the underlying client is still done here) and
+   // returns 1 if it was sent (or the client is already connected), 0 if there was an error
+   boolean beginConnect(const char* id);
+   boolean beginConnect(const char* id, const char* user, const char* pass);
+   boolean beginConnect(const char* id, const char* user, const char* pass, const char* willTopic, uint8_t willQos, boolean willRetain, const char* willMessage, boolean cleanSession);
+   // Checks for CONNACK without blocking
+   // Returns MQTT_POLL_IN_PROGRESS, MQTT_POLL_CONNECTED or MQTT_POLL_FAILED (reason in state())
+   int connectPoll();
    void disconnect();
    boolean publish(const char* topic, const char* payload);
    boolean publish(const char* topic, const char* payload, boolean retained);
    boolean publish(const char* topic, const uint8_t * payload, unsigned int plength);
    boolean publish(const char* topic, const uint8_t * payload, unsigned int plength, boolean retained);
+   // QoS 0 or 1. A QoS 1 message is kept until PUBACK and sent again (with DUP) after a reconnect.
+   // Returns 0 if the in-flight window is full or the packet is longer than MQTT_INFLIGHT_PACKET_SIZE
+   boolean publish(const char* topic, const uint8_t * payload, unsigned int plength, boolean retained, uint8_t qos);
+   // Payload given as count segments, sent one after another without putting them together.
+   // QoS 0: header and topic go from the buffer and each segment with its own write, so the payload
+   // is not limited by the buffer size. QoS 1: the packet is put together once, in the in-flight slot
+   boolean publishv(const char* topic, const MQTTSegment* segments, uint8_t count, boolean retained);
+   boolean publishv(const char* topic, const MQTTSegment* segments, uint8_t count, boolean retained, uint8_t qos);
    boolean publish_P(const char* topic, const char* payload, boolean retained);
    boolean publish_P(const char* topic, const uint8_t * payload, unsigned int plength, boolean retained);
    // Start to publish a message.
@@ -163,8 +374,26 @@ public:
    virtual size_t write(const uint8_t *buffer, size_t size);
    boolean subscribe(const char* topic);
    boolean subscribe(const char* topic, uint8_t qos);
+   // n topic filters (qos can be NULL for all 0) in as few SUBSCRIBE packets as the buffer allows.
+   // Returns 0 if a filter is too long, a qos is invalid or a packet couldn't be sent
+   boolean subscribe(const char* const* topics, const uint8_t* qos, size_t n);
+   uint8_t subscribePending();    // SUBSCRIBE packets not acknowledged yet
+   uint32_t subscribeRefused();   // filters the server refused in SUBACK (0x80)
+   // A refused filter closes the connection: loop() returns false with the state MQTT_SUBSCRIBE_REFUSED,
+   // so the caller's reconnect (and its backoff) subscribes again
+   PubSubClient& setDisconnectOnRefused(boolean enabled);
    boolean unsubscribe(const char* topic);
    boolean loop();
+   // Keep publish() calls made while disconnected (one per topic, the newest value) and send them after CONNACK.
+   // When the queue is full the oldest message is dropped
+   PubSubClient& setOfflineQueue(boolean enabled);
+   uint8_t offlinePending();
+   uint32_t offlineQueued();     // accepted into the queue
+   uint32_t offlineDropped();    // lost - queue full or message too long
+   uint32_t offlineCoalesced();  // replaced by a newer message for the same topic
+   // Number of QoS 1 messages waiting for PUBACK at the same time (1..MQTT_MAX_INFLIGHT)
+   PubSubClient& setInflightWindow(uint8_t size);
+   uint8_t inflightCount();
    boolean connected();
    int state();
 };
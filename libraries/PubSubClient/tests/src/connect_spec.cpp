@@ -3,6 +3,7 @@
 #include "Buffer.h"
 #include "BDDTest.h"
 #include "trace.h"
+#include "VirtualClock.h"
 
 
 byte server[] = { 172, 16, 0, 2 };
@@ -28,14 +29,41 @@ int test_connect_fails_on_no_response() {
     IT("fails to connect if no response received after 15 seconds");
     ShimClient shimClient;
     shimClient.setAllowConnect(true);
+    shimClient.setIdleAdvance(10);
+    VirtualClock::set(0);
     PubSubClient client(server, 1883, callback, shimClient);
+    client.setClock(VirtualClock::millis);
     int rc = client.connect((char*)"client_test1");
     IS_FALSE(rc);
+    IS_TRUE(VirtualClock::millis() >= 15000 && VirtualClock::millis() <= 15010);
     int state = client.state();
     IS_TRUE(state == MQTT_CONNECTION_TIMEOUT);
     END_IT
 }
 
+int test_connect_runtime_keepalive_timeout() {
+    IT("sends the keepalive and waits for the socket timeout set at runtime");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connect[] = {0x10,0x18,0x0,0x4,0x4d,0x51,0x54,0x54,0x4,0x2,0x0,0x1e,0x0,0xc,0x63,0x6c,0x69,0x65,0x6e,0x74,0x5f,0x74,0x65,0x73,0x74,0x31};
+    shimClient.expect(connect,26);
+
+    shimClient.setIdleAdvance(10);
+    VirtualClock::set(0);
+    PubSubClient client(server, 1883, callback, shimClient);
+    client.setClock(VirtualClock::millis);
+    client.setKeepAlive(30);
+    client.setSocketTimeout(1);
+    int rc = client.connect((char*)"client_test1");
+    IS_FALSE(rc);
+    IS_TRUE(VirtualClock::millis() >= 1000 && VirtualClock::millis() <= 1010);
+    int state = client.state();
+    IS_TRUE(state == MQTT_CONNECTION_TIMEOUT);
+    IS_FALSE(shimClient.error());
+    END_IT
+}
+
 int test_connect_properly_formatted() {
     IT("sends a properly formatted connect packet and succeeds");
     ShimClient shimClient;
@@ -280,12 +308,96 @@ int test_connect_disconnect_connect() {
     END_IT
 }
 
+int test_begin_connect_in_progress_until_connack() {
+    IT("begins to connect and polls until the connack arrives");
+    ShimClient shimClient;
+
+    shimClient.setAllowConnect(true);
+    byte connect[] = {0x10,0x18,0x0,0x4,0x4d,0x51,0x54,0x54,0x4,0x2,0x0,0xf,0x0,0xc,0x63,0x6c,0x69,0x65,0x6e,0x74,0x5f,0x74,0x65,0x73,0x74,0x31};
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.expect(connect,26);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.beginConnect((char*)"client_test1");
+    IS_TRUE(rc);
+    IS_FALSE(shimClient.error());
+    IS_TRUE(client.state() == MQTT_CONNECTING);
+    IS_FALSE(client.connected());
+
+    rc = client.connectPoll();
+    IS_TRUE(rc == MQTT_POLL_IN_PROGRESS);
+    IS_FALSE(client.connected());
+    IS_FALSE(client.loop());
+
+    shimClient.respond(connack,4);
+    rc = client.connectPoll();
+    IS_TRUE(rc == MQTT_POLL_CONNECTED);
+    IS_TRUE(client.state() == MQTT_CONNECTED);
+    IS_TRUE(client.connected());
+
+    rc = client.connectPoll();
+    IS_TRUE(rc == MQTT_POLL_CONNECTED);
+
+    END_IT
+}
+
+int test_begin_connect_fails_no_network() {
+    IT("fails to begin to connect if underlying client doesn't connect");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(false);
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.beginConnect((char*)"client_test1");
+    IS_FALSE(rc);
+    IS_TRUE(client.state() == MQTT_CONNECT_FAILED);
+
+    rc = client.connectPoll();
+    IS_TRUE(rc == MQTT_POLL_FAILED);
+    END_IT
+}
+
+int test_connect_poll_fails_on_bad_rc() {
+    IT("polls a bad return code as failed");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+    byte connack[] = { 0x20, 0x02, 0x00, 0x04 };
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.beginConnect((char*)"client_test1",(char*)"user",(char*)"pass");
+    IS_TRUE(rc);
+
+    shimClient.respond(connack,4);
+    rc = client.connectPoll();
+    IS_TRUE(rc == MQTT_POLL_FAILED);
+    IS_TRUE(client.state() == MQTT_CONNECT_BAD_CREDENTIALS);
+    IS_FALSE(shimClient.connected());
+
+    END_IT
+}
+
+int test_connect_poll_fails_on_connection_lost() {
+    IT("polls a connection closed before connack as failed");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.beginConnect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    shimClient.setConnected(false);
+    rc = client.connectPoll();
+    IS_TRUE(rc == MQTT_POLL_FAILED);
+    IS_TRUE(client.state() == MQTT_CONNECT_FAILED);
+
+    END_IT
+}
+
 int main()
 {
     SUITE("Connect");
 
     test_connect_fails_no_network();
     test_connect_fails_on_no_response();
+    test_connect_runtime_keepalive_timeout();
 
     test_connect_properly_formatted();
     test_connect_non_clean_session();
@@ -298,5 +410,10 @@ int main()
     test_connect_with_will();
     test_connect_with_will_username_password();
     test_connect_disconnect_connect();
+
+    test_begin_connect_in_progress_until_connack();
+    test_begin_connect_fails_no_network();
+    test_connect_poll_fails_on_bad_rc();
+    test_connect_poll_fails_on_connection_lost();
     FINISH
 }
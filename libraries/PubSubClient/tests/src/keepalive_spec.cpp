@@ -3,7 +3,8 @@
 #include "Buffer.h"
 #include "BDDTest.h"
 #include "trace.h"
-#include <unistd.h>
+#include "VirtualClock.h"
+#include <limits.h>
 
 byte server[] = { 172, 16, 0, 2 };
 
@@ -13,7 +14,7 @@ void callback(char* topic, byte* payload, unsigned int length) {
 
 
 int test_keepalive_pings_idle() {
-    IT("keeps an idle connection alive (takes 1 minute)");
+    IT("keeps an idle connection alive (1 virtual minute)");
 
     ShimClient shimClient;
     shimClient.setAllowConnect(true);
@@ -21,7 +22,9 @@ int test_keepalive_pings_idle() {
     byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
     shimClient.respond(connack,4);
 
+    VirtualClock::set(0);
     PubSubClient client(server, 1883, callback, shimClient);
+    client.setClock(VirtualClock::millis);
     int rc = client.connect((char*)"client_test1");
     IS_TRUE(rc);
 
@@ -31,7 +34,7 @@ int test_keepalive_pings_idle() {
     shimClient.respond(pingresp,2);
 
     for (int i = 0; i < 50; i++) {
-        sleep(1);
+        VirtualClock::advance(1000);
         if ( i == 15 || i == 31 || i == 47) {
             shimClient.expect(pingreq,2);
             shimClient.respond(pingresp,2);
@@ -45,8 +48,8 @@ int test_keepalive_pings_idle() {
     END_IT
 }
 
-int test_keepalive_pings_with_outbound_qos0() {
-    IT("keeps a connection alive that only sends qos0 (takes 1 minute)");
+int test_keepalive_no_pings_outbound_qos0() {
+    IT("does not send pings for connections that send qos0 (1 virtual minute)");
 
     ShimClient shimClient;
     shimClient.setAllowConnect(true);
@@ -54,7 +57,9 @@ int test_keepalive_pings_with_outbound_qos0() {
     byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
     shimClient.respond(connack,4);
 
+    VirtualClock::set(0);
     PubSubClient client(server, 1883, callback, shimClient);
+    client.setClock(VirtualClock::millis);
     int rc = client.connect((char*)"client_test1");
     IS_TRUE(rc);
 
@@ -66,13 +71,7 @@ int test_keepalive_pings_with_outbound_qos0() {
         rc = client.publish((char*)"topic",(char*)"payload");
         IS_TRUE(rc);
         IS_FALSE(shimClient.error());
-        sleep(1);
-        if ( i == 15 || i == 31 || i == 47) {
-            byte pingreq[] = { 0xC0,0x0 };
-            shimClient.expect(pingreq,2);
-            byte pingresp[] = { 0xD0,0x0 };
-            shimClient.respond(pingresp,2);
-        }
+        VirtualClock::advance(1000);
         rc = client.loop();
         IS_TRUE(rc);
         IS_FALSE(shimClient.error());
@@ -82,7 +81,7 @@ int test_keepalive_pings_with_outbound_qos0() {
 }
 
 int test_keepalive_pings_with_inbound_qos0() {
-    IT("keeps a connection alive that only receives qos0 (takes 1 minute)");
+    IT("keeps a connection alive that only receives qos0 (1 virtual minute)");
 
     ShimClient shimClient;
     shimClient.setAllowConnect(true);
@@ -90,7 +89,9 @@ int test_keepalive_pings_with_inbound_qos0() {
     byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
     shimClient.respond(connack,4);
 
+    VirtualClock::set(0);
     PubSubClient client(server, 1883, callback, shimClient);
+    client.setClock(VirtualClock::millis);
     int rc = client.connect((char*)"client_test1");
     IS_TRUE(rc);
 
@@ -98,7 +99,7 @@ int test_keepalive_pings_with_inbound_qos0() {
 
     for (int i = 0; i < 50; i++) {
         TRACE(i<<":");
-        sleep(1);
+        VirtualClock::advance(1000);
         if ( i == 15 || i == 31 || i == 47) {
             byte pingreq[] = { 0xC0,0x0 };
             shimClient.expect(pingreq,2);
@@ -115,7 +116,7 @@ int test_keepalive_pings_with_inbound_qos0() {
 }
 
 int test_keepalive_no_pings_inbound_qos1() {
-    IT("does not send pings for connections with inbound qos1 (takes 1 minute)");
+    IT("does not send pings for connections with inbound qos1 (1 virtual minute)");
 
     ShimClient shimClient;
     shimClient.setAllowConnect(true);
@@ -123,7 +124,9 @@ int test_keepalive_no_pings_inbound_qos1() {
     byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
     shimClient.respond(connack,4);
 
+    VirtualClock::set(0);
     PubSubClient client(server, 1883, callback, shimClient);
+    client.setClock(VirtualClock::millis);
     int rc = client.connect((char*)"client_test1");
     IS_TRUE(rc);
 
@@ -133,7 +136,7 @@ int test_keepalive_no_pings_inbound_qos1() {
     for (int i = 0; i < 50; i++) {
         shimClient.respond(publish,18);
         shimClient.expect(puback,4);
-        sleep(1);
+        VirtualClock::advance(1000);
         rc = client.loop();
         IS_TRUE(rc);
         IS_FALSE(shimClient.error());
@@ -143,7 +146,7 @@ int test_keepalive_no_pings_inbound_qos1() {
 }
 
 int test_keepalive_disconnects_hung() {
-    IT("disconnects a hung connection (takes 30 seconds)");
+    IT("disconnects a hung connection (30 virtual seconds)");
 
     ShimClient shimClient;
     shimClient.setAllowConnect(true);
@@ -151,7 +154,9 @@ int test_keepalive_disconnects_hung() {
     byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
     shimClient.respond(connack,4);
 
+    VirtualClock::set(0);
     PubSubClient client(server, 1883, callback, shimClient);
+    client.setClock(VirtualClock::millis);
     int rc = client.connect((char*)"client_test1");
     IS_TRUE(rc);
 
@@ -159,7 +164,7 @@ int test_keepalive_disconnects_hung() {
     shimClient.expect(pingreq,2);
 
     for (int i = 0; i < 32; i++) {
-        sleep(1);
+        VirtualClock::advance(1000);
         rc = client.loop();
     }
     IS_FALSE(rc);
@@ -172,14 +177,119 @@ int test_keepalive_disconnects_hung() {
     END_IT
 }
 
+int test_keepalive_runtime() {
+    IT("pings after the keepalive set at runtime (2 virtual seconds)");
+
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connect[] = {0x10,0x18,0x0,0x4,0x4d,0x51,0x54,0x54,0x4,0x2,0x0,0x1,0x0,0xc,0x63,0x6c,0x69,0x65,0x6e,0x74,0x5f,0x74,0x65,0x73,0x74,0x31};
+    shimClient.expect(connect,26);
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    VirtualClock::set(0);
+    PubSubClient client(server, 1883, callback, shimClient);
+    client.setClock(VirtualClock::millis);
+    client.setKeepAlive(1);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+    IS_TRUE(client.nextKeepAlive() == 1001);
+
+    byte pingreq[] = { 0xC0,0x0 };
+    shimClient.expect(pingreq,2);
+    VirtualClock::advance(2000);
+    IS_TRUE(client.nextKeepAlive() == 0);
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_keepalive_next() {
+    IT("tells how long until the next keepalive");
+
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    VirtualClock::set(0);
+    PubSubClient client(server, 1883, callback, shimClient);
+    client.setClock(VirtualClock::millis);
+    IS_TRUE(client.nextKeepAlive() == ULONG_MAX);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    unsigned long next = client.nextKeepAlive();
+    IS_TRUE(next == 15001);
+
+    client.setKeepAlive(0);
+    IS_TRUE(client.nextKeepAlive() == ULONG_MAX);
+
+    END_IT
+}
+
+int test_keepalive_day() {
+    IT("keeps an idle connection alive for a day and reconnects after a hang (virtual time)");
+
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    VirtualClock::set(0);
+    PubSubClient client(server, 1883, callback, shimClient);
+    client.setClock(VirtualClock::millis);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    // The server answers every ping - one every 16 seconds, loop() runs once a second
+    byte pingresp[] = { 0xD0,0x0 };
+    uint16_t writes = shimClient.writes();
+    unsigned long pings = 0;
+    for (unsigned long i = 0; i < 24*3600UL; i++) {
+        VirtualClock::advance(1000);
+        rc = client.loop();
+        IS_TRUE(rc);
+        if (shimClient.writes() != writes) {
+            writes = shimClient.writes();
+            pings++;
+            shimClient.respond(pingresp,2);
+        }
+    }
+    IS_TRUE(pings == 24*3600UL/16);
+
+    // Now the server stops answering: the connection is dropped one keepalive after the ping
+    unsigned long hung = VirtualClock::millis();
+    while (client.loop()) {
+        VirtualClock::advance(1000);
+    }
+    IS_TRUE(client.state() == MQTT_CONNECTION_TIMEOUT);
+    IS_TRUE(VirtualClock::millis()-hung <= 32000);
+
+    shimClient.respond(connack,4);
+    rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+    IS_TRUE(client.nextKeepAlive() == 15001);
+
+    END_IT
+}
+
 int main()
 {
     SUITE("Keep-alive");
     test_keepalive_pings_idle();
-    test_keepalive_pings_with_outbound_qos0();
+    test_keepalive_no_pings_outbound_qos0();
     test_keepalive_pings_with_inbound_qos0();
     test_keepalive_no_pings_inbound_qos1();
     test_keepalive_disconnects_hung();
+    test_keepalive_runtime();
+    test_keepalive_next();
+    test_keepalive_day();
 
     FINISH
 }
@@ -20,6 +20,8 @@ extern "C"{
 
 #define PROGMEM
 #define pgm_read_byte_near(x) *(x)
+#define memcpy_P memcpy
+#define strlen_P strlen
 
 #define yield(x) {}
 
@@ -15,6 +15,10 @@ bool Buffer::available() {
     return this->pos < this->length;
 }
 
+size_t Buffer::remaining() {
+    return this->length - this->pos;
+}
+
 uint8_t Buffer::next() {
     if (this->available()) {
         return this->buffer[this->pos++];
@@ -27,8 +31,13 @@ void Buffer::reset() {
 }
 
 void Buffer::add(uint8_t* buf, size_t size) {
-    uint16_t i = 0;
-    for (;i<size;i++) {
+    if (this->pos == this->length) {
+        // Everything was read - start from the beginning again
+        this->pos = 0;
+        this->length = 0;
+    }
+    size_t i = 0;
+    for (;i<size && this->length<sizeof(this->buffer);i++) {
         this->buffer[this->length++] = buf[i];
     }
 }
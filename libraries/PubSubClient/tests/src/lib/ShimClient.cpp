@@ -1,5 +1,6 @@
 #include "ShimClient.h"
 #include "trace.h"
+#include "VirtualClock.h"
 #include <iostream>
 #include <Arduino.h>
 #include <ctime>
@@ -15,12 +16,20 @@ ShimClient::ShimClient() {
     this->expectBuffer = new Buffer();
     this->_allowConnect = true;
     this->_connected = false;
+    this->_closeWhenRead = false;
+    this->_idleAdvance = 0;
     this->_error = false;
     this->expectAnything = true;
     this->_received = 0;
+    this->_writes = 0;
     this->_expectedPort = 0;
 }
 
+ShimClient::~ShimClient() {
+    delete this->responseBuffer;
+    delete this->expectBuffer;
+}
+
 int ShimClient::connect(IPAddress ip, uint16_t port) {
     if (this->_allowConnect) {
         this->_connected = true;
@@ -56,6 +65,7 @@ int ShimClient::connect(const char *host, uint16_t port)  {
 }
 size_t ShimClient::write(uint8_t b)  {
     this->_received += 1;
+    this->_writes += 1;
     TRACE(std::hex << (unsigned int)b);
     if (!this->expectAnything) {
         if (this->expectBuffer->available()) {
@@ -73,6 +83,7 @@ size_t ShimClient::write(uint8_t b)  {
 }
 size_t ShimClient::write(const uint8_t *buf, size_t size)  {
     this->_received += size;
+    this->_writes += 1;
     TRACE( "[" << std::dec << (unsigned int)(size) << "] ");
     uint16_t i=0;
     for (;i<size;i++) {
@@ -97,22 +108,31 @@ size_t ShimClient::write(const uint8_t *buf, size_t size)  {
     return size;
 }
 int ShimClient::available()  {
-    return this->responseBuffer->available();
+    int n = this->responseBuffer->remaining();
+    if (n == 0 && this->_idleAdvance > 0) {
+        VirtualClock::advance(this->_idleAdvance);
+    }
+    return n;
 }
 int ShimClient::read()  { return this->responseBuffer->next(); }
 int ShimClient::read(uint8_t *buf, size_t size) {
-    uint16_t i = 0;
-    for (;i<size;i++) {
+    size_t i = 0;
+    for (;i<size && this->responseBuffer->available();i++) {
         buf[i] = this->read();
     }
-    return size;
+    return i;
 }
 int ShimClient::peek()  { return 0; }
 void ShimClient::flush() {}
 void ShimClient::stop() {
     this->setConnected(false);
 }
-uint8_t ShimClient::connected() { return this->_connected; }
+uint8_t ShimClient::connected() {
+    if (this->_closeWhenRead && !this->responseBuffer->available()) {
+        this->_connected = false;
+    }
+    return this->_connected;
+}
 ShimClient::operator bool() { return true; }
 
 
@@ -130,6 +150,12 @@ ShimClient* ShimClient::expect(uint8_t *buf, size_t size) {
 void ShimClient::setConnected(bool b) {
     this->_connected = b;
 }
+void ShimClient::setCloseWhenRead(bool b) {
+    this->_closeWhenRead = b;
+}
+void ShimClient::setIdleAdvance(unsigned long ms) {
+    this->_idleAdvance = ms;
+}
 void ShimClient::setAllowConnect(bool b) {
     this->_allowConnect = b;
 }
@@ -142,6 +168,10 @@ uint16_t ShimClient::received() {
     return this->_received;
 }
 
+uint16_t ShimClient::writes() {
+    return this->_writes;
+}
+
 void ShimClient::expectConnect(IPAddress ip, uint16_t port) {
     this->_expectedIP = ip;
     this->_expectedPort = port;
@@ -13,15 +13,19 @@ private:
     Buffer* expectBuffer;
     bool _allowConnect;
     bool _connected;
+    bool _closeWhenRead;
+    unsigned long _idleAdvance;
     bool expectAnything;
     bool _error;
     uint16_t _received;
+    uint16_t _writes;
     IPAddress _expectedIP;
     uint16_t _expectedPort;
     const char* _expectedHost;
     
 public:
   ShimClient();
+  virtual ~ShimClient();
   virtual int connect(IPAddress ip, uint16_t port);
   virtual int connect(const char *host, uint16_t port);
   virtual size_t write(uint8_t);
@@ -42,10 +46,16 @@ public:
   virtual void expectConnect(const char *host, uint16_t port);
   
   virtual uint16_t received();
+  virtual uint16_t writes();  // write calls
   virtual bool error();
   
   virtual void setAllowConnect(bool b);
   virtual void setConnected(bool b);
+  // The server closes the connection once everything given to respond() is read
+  virtual void setCloseWhenRead(bool b);
+  // With nothing to read, every available() moves the VirtualClock on by ms - the
+  // client's wait for data takes virtual time instead of real time. 0 (default) = off
+  virtual void setIdleAdvance(unsigned long ms);
 };
 
 #endif
@@ -0,0 +1,15 @@
+#include "VirtualClock.h"
+
+unsigned long VirtualClock::_now = 0;
+
+unsigned long VirtualClock::millis() {
+    return _now;
+}
+
+void VirtualClock::advance(unsigned long ms) {
+    _now += ms;
+}
+
+void VirtualClock::set(unsigned long ms) {
+    _now = ms;
+}
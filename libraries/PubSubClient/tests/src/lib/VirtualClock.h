@@ -0,0 +1,16 @@
+#ifndef virtualclock_h
+#define virtualclock_h
+
+// Milliseconds that only pass when a test (or an idle ShimClient) moves them on.
+// Handed to PubSubClient::setClock so keepalive and timeouts run without waiting
+class VirtualClock {
+private:
+    static unsigned long _now;
+
+public:
+    static unsigned long millis();
+    static void advance(unsigned long ms);
+    static void set(unsigned long ms);
+};
+
+#endif
@@ -5,6 +5,12 @@
 #include <stdlib.h>
 
 #define LOG(x) {std::cout << x << std::flush; }
-#define TRACE(x) {if (getenv("TRACE")) { std::cout << x << std::flush; }}
+// getenv only once - TRACE is called for every byte written
+inline bool traceEnabled() {
+    static bool enabled = getenv("TRACE") != NULL;
+    return enabled;
+}
+
+#define TRACE(x) {if (traceEnabled()) { std::cout << x << std::flush; }}
 
 #endif
@@ -146,6 +146,39 @@ int test_publish_too_long() {
     END_IT
 }
 
+int test_publish_larger_tx_buffer() {
+    IT("publishes a message longer than the default buffer after setBufferSize");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    IS_TRUE(client.setBufferSize(32,256));
+    IS_TRUE(client.getBufferSize() == 256);
+    IS_TRUE(client.getRxBufferSize() == 32);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte payload[250];
+    memset(payload,'x',250);
+    byte publish[209] = {0x30,0xce,0x1,0x0,0x5,0x74,0x6f,0x70,0x69,0x63};
+    memcpy(publish+10,payload,199);
+    shimClient.expect(publish,209);
+
+    rc = client.publish((char*)"topic",payload,199);
+    IS_TRUE(rc);
+
+    // 5+7+250 bytes don't fit into 256
+    rc = client.publish((char*)"topic",payload,250);
+    IS_FALSE(rc);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
 int test_publish_P() {
     IT("publishes using PROGMEM");
     ShimClient shimClient;
@@ -164,16 +197,340 @@ int test_publish_P() {
     byte publish[] = {0x31,0xc,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x1,0x2,0x3,0x0,0x5};
     shimClient.expect(publish,14);
 
+    uint16_t writes = shimClient.writes();
     rc = client.publish_P((char*)"topic",payload,length,true);
     IS_TRUE(rc);
+    IS_TRUE(shimClient.writes() == writes+1);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+
+
+
+int test_publish_P_long() {
+    IT("publishes a long PROGMEM payload in buffer sized writes");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte payload[300];
+    for (int i = 0;i<300;i++) {
+        payload[i] = i;
+    }
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte publish[310] = {0x30,0xb3,0x2,0x0,0x5,0x74,0x6f,0x70,0x69,0x63};
+    memcpy(publish+10,payload,300);
+    shimClient.expect(publish,310);
+
+    uint16_t writes = shimClient.writes();
+    uint16_t received = shimClient.received();
+    rc = client.publish_P((char*)"topic",payload,300,false);
+    IS_TRUE(rc);
+    // 128 byte buffer: header, topic and 118 bytes, then 128 and 54 bytes
+    IS_TRUE(shimClient.writes() == writes+3);
+    IS_TRUE(shimClient.received() == received+310);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_publishv() {
+    IT("publishes segments without putting them together");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte publish[] = {0x31,0xe,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    shimClient.expect(publish,16);
+
+    MQTTSegment segments[] = {{(const uint8_t*)"pay",3},{(const uint8_t*)"",0},{(const uint8_t*)"load",4}};
+    uint16_t writes = shimClient.writes();
+    rc = client.publishv((char*)"topic",segments,3,true);
+    IS_TRUE(rc);
+    // header with topic, then the two segments that aren't empty
+    IS_TRUE(shimClient.writes() == writes+3);
 
     IS_FALSE(shimClient.error());
 
     END_IT
 }
 
+int test_publishv_longer_than_buffer() {
+    IT("publishes segments longer than the buffer");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte payload[200];
+    memset(payload,'x',200);
+    byte publish[210] = {0x30,0xcf,0x1,0x0,0x5,0x74,0x6f,0x70,0x69,0x63};
+    memcpy(publish+10,payload,200);
+    shimClient.expect(publish,210);
+
+    MQTTSegment segments[] = {{payload,100},{payload+100,100}};
+    rc = client.publishv((char*)"topic",segments,2,false);
+    IS_TRUE(rc);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_publishv_qos1() {
+    IT("publishes qos1 segments with one write");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte publish[] = {0x32,0x10,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x0,0x2,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    shimClient.expect(publish,18);
+
+    MQTTSegment segments[] = {{(const uint8_t*)"pay",3},{(const uint8_t*)"load",4}};
+    uint16_t writes = shimClient.writes();
+    rc = client.publishv((char*)"topic",segments,2,false,1);
+    IS_TRUE(rc);
+    IS_TRUE(shimClient.writes() == writes+1);
+    IS_TRUE(client.inflightCount() == 1);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_publish_qos1() {
+    IT("publishes qos1 and releases it on puback");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
 
+    byte publish[] = {0x32,0x10,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x0,0x2,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    shimClient.expect(publish,18);
 
+    rc = client.publish((char*)"topic",(byte*)"payload",7,false,1);
+    IS_TRUE(rc);
+    IS_FALSE(shimClient.error());
+    IS_TRUE(client.inflightCount() == 1);
+
+    byte puback[] = { 0x40, 0x02, 0x00, 0x02 };
+    shimClient.respond(puback,4);
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_TRUE(client.inflightCount() == 0);
+
+    END_IT
+}
+
+int test_publish_qos1_window_full() {
+    IT("refuses qos1 publish when the in-flight window is full");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    client.setInflightWindow(2);
+    rc = client.publish((char*)"topic",(byte*)"payload",7,false,1);
+    IS_TRUE(rc);
+    rc = client.publish((char*)"topic",(byte*)"payload",7,false,1);
+    IS_TRUE(rc);
+    rc = client.publish((char*)"topic",(byte*)"payload",7,false,1);
+    IS_FALSE(rc);
+    IS_TRUE(client.inflightCount() == 2);
+
+    // qos0 is not limited by the window
+    rc = client.publish((char*)"topic",(byte*)"payload",7,false,0);
+    IS_TRUE(rc);
+
+    byte puback[] = { 0x40, 0x02, 0x00, 0x03 };
+    shimClient.respond(puback,4);
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_TRUE(client.inflightCount() == 1);
+    rc = client.publish((char*)"topic",(byte*)"payload",7,false,1);
+    IS_TRUE(rc);
+
+    END_IT
+}
+
+int test_publish_qos1_too_long() {
+    IT("refuses a qos1 publish longer than an in-flight slot without using a msgId");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte payload[MQTT_INFLIGHT_PACKET_SIZE];
+    memset(payload,'A',sizeof(payload));
+    rc = client.publish((char*)"topic",payload,sizeof(payload),false,1);
+    IS_FALSE(rc);
+    IS_TRUE(client.inflightCount() == 0);
+
+    // Still the first msgId
+    byte publish[] = {0x32,0x10,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x0,0x2,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    shimClient.expect(publish,18);
+    rc = client.publish((char*)"topic",(byte*)"payload",7,false,1);
+    IS_TRUE(rc);
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_publish_qos1_resend_on_reconnect() {
+    IT("resends unacknowledged qos1 with dup after reconnect");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte publish[] = {0x33,0x10,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x0,0x2,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    shimClient.expect(publish,18);
+    rc = client.publish((char*)"topic",(byte*)"payload",7,true,1);
+    IS_TRUE(rc);
+    IS_FALSE(shimClient.error());
+
+    // Connection silently lost, no puback
+    shimClient.setConnected(false);
+    IS_FALSE(client.loop());
+
+    byte connect[] = {0x10,0x18,0x0,0x4,0x4d,0x51,0x54,0x54,0x4,0x2,0x0,0xf,0x0,0xc,0x63,0x6c,0x69,0x65,0x6e,0x74,0x5f,0x74,0x65,0x73,0x74,0x31};
+    byte dup[] = {0x3b,0x10,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x0,0x2,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    shimClient.expect(connect,26);
+    shimClient.expect(dup,18);
+    shimClient.respond(connack,4);
+    rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+    IS_FALSE(shimClient.error());
+    IS_TRUE(client.inflightCount() == 1);
+
+    // New ids skip the one still in flight
+    byte subscribe[] = { 0x82,0xa,0x0,0x3,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x0 };
+    shimClient.expect(subscribe,12);
+    rc = client.subscribe((char*)"topic");
+    IS_TRUE(rc);
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_publish_offline_queue() {
+    IT("queues publishes while disconnected and sends the newest per topic after connack");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    client.setOfflineQueue(true);
+
+    int rc = client.publish((char*)"topic",(char*)"old");
+    IS_TRUE(rc);
+    rc = client.publish((char*)"other",(char*)"x",true);
+    IS_TRUE(rc);
+    rc = client.publish((char*)"topic",(char*)"payload");
+    IS_TRUE(rc);
+    IS_TRUE(client.offlinePending() == 2);
+    IS_TRUE(client.offlineQueued() == 3);
+    IS_TRUE(client.offlineCoalesced() == 1);
+    IS_TRUE(client.offlineDropped() == 0);
+
+    byte connect[] = {0x10,0x18,0x0,0x4,0x4d,0x51,0x54,0x54,0x4,0x2,0x0,0xf,0x0,0xc,0x63,0x6c,0x69,0x65,0x6e,0x74,0x5f,0x74,0x65,0x73,0x74,0x31};
+    byte publish[] = {0x30,0xe,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    byte publish2[] = {0x31,0x8,0x0,0x5,0x6f,0x74,0x68,0x65,0x72,0x78};
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.expect(connect,26);
+    shimClient.expect(publish,16);
+    shimClient.expect(publish2,10);
+    shimClient.respond(connack,4);
+
+    rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+    IS_FALSE(shimClient.error());
+    IS_TRUE(client.offlinePending() == 0);
+
+    END_IT
+}
+
+int test_publish_offline_queue_full() {
+    IT("drops the oldest queued publish when the queue is full");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    client.setOfflineQueue(true);
+
+    char topic[] = "topicA";
+    for (int i = 0; i <= MQTT_QUEUE_LENGTH; i++) {
+        topic[5] = 'A'+i;
+        int rc = client.publish(topic,(char*)"payload");
+        IS_TRUE(rc);
+    }
+    IS_TRUE(client.offlinePending() == MQTT_QUEUE_LENGTH);
+    IS_TRUE(client.offlineDropped() == 1);
+
+    // Longer than MQTT_QUEUE_ENTRY_SIZE
+    char payload[MQTT_QUEUE_ENTRY_SIZE+1];
+    memset(payload,'A',MQTT_QUEUE_ENTRY_SIZE);
+    payload[MQTT_QUEUE_ENTRY_SIZE] = 0;
+    int rc = client.publish((char*)"topic",payload);
+    IS_FALSE(rc);
+    IS_TRUE(client.offlineDropped() == 2);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+    rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+    IS_TRUE(client.offlinePending() == 0);
+    // connect + 17 byte publish for each
+    IS_TRUE(shimClient.received() == 26+MQTT_QUEUE_LENGTH*17);
+
+    END_IT
+}
 
 int main()
 {
@@ -184,7 +541,18 @@ int main()
     test_publish_retained_2();
     test_publish_not_connected();
     test_publish_too_long();
+    test_publish_larger_tx_buffer();
     test_publish_P();
+    test_publish_P_long();
+    test_publishv();
+    test_publishv_longer_than_buffer();
+    test_publishv_qos1();
+    test_publish_qos1();
+    test_publish_qos1_window_full();
+    test_publish_qos1_too_long();
+    test_publish_qos1_resend_on_reconnect();
+    test_publish_offline_queue();
+    test_publish_offline_queue_full();
 
     FINISH
 }
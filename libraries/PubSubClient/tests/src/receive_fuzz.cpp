@@ -0,0 +1,137 @@
+#include "PubSubClient.h"
+#include "ShimClient.h"
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+
+// Random byte streams from the server into connect()/loop()/readPacket(), with the ShimClient.
+// Built with libFuzzer (make fuzz, clang) or, without it, with random inputs (make fuzz_random)
+
+byte server[] = { 172, 16, 0, 2 };
+
+void callback(char* topic, byte* payload, unsigned int length) {
+    // Touch all of it - the sanitizers find reads outside the buffer
+    volatile uint8_t sum = 0;
+    for (unsigned int i = 0;i<length;i++) {
+        sum += payload[i];
+    }
+    sum += strlen(topic);
+}
+
+void view_callback(const char* topic, size_t topicLen, const uint8_t* payload, size_t length, uint16_t msgId, uint8_t qos, boolean retain) {
+    volatile uint8_t sum = 0;
+    for (size_t i = 0;i<topicLen;i++) {
+        sum += topic[i];
+    }
+    for (size_t i = 0;i<length;i++) {
+        sum += payload[i];
+    }
+}
+
+void chunk_callback(const char* topic, size_t topicLen, const uint8_t* chunk, size_t length, size_t offset, size_t total) {
+    volatile uint8_t sum = 0;
+    for (size_t i = 0;i<length;i++) {
+        sum += chunk[i];
+    }
+}
+
+// First byte: options, then what the server sends (CONNACK included)
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    if (size < 1 || size > 1024) {
+        return 0;
+    }
+    uint8_t options = data[0];
+
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+    shimClient.respond((uint8_t*)data+1,size-1);
+    // A packet cut off at the end must not wait for the socket timeout
+    shimClient.setCloseWhenRead(true);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    if (options & 0x40) {
+        // One for all inputs, the Stream of the tests is never freed
+        static Stream stream;
+        client.setStream(stream);
+    }
+    if (options & 0x01) {
+        client.setProtocolVersion(MQTT_VERSION_5);
+    }
+    if (options & 0x02) {
+        client.setViewCallback(view_callback);
+    }
+    if (options & 0x04) {
+        client.setChunkCallback(chunk_callback);
+    }
+    if (options & 0x08) {
+        client.setBufferSize(MQTT_MIN_BUFFER_SIZE + (options >> 4));
+    }
+    if (options & 0x10) {
+        client.addFilter("a/+/c",view_callback);
+        client.addFilter("#",view_callback);
+    }
+    if (!client.connect((char*)"client_fuzz")) {
+        return 0;
+    }
+    if (options & 0x20) {
+        // Something in flight for PUBACK and SUBACK to match
+        client.publish((char*)"topic",(const uint8_t*)"payload",7,false,1);
+        client.subscribe((char*)"topic");
+    }
+    // Every loop reads a packet, or fails - it can't take longer than the input
+    for (size_t i = 0;i<size && client.loop();i++) {
+    }
+    return 0;
+}
+
+#ifndef LIBFUZZER
+// A few packets with a random type, length and content (the length matches the content only sometimes)
+size_t randomInput(uint8_t* data, size_t size) {
+    size_t pos = 0;
+    data[pos++] = rand();
+    uint8_t connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    if (rand() % 8 != 0) {
+        memcpy(data+pos,connack,4);
+        pos += 4;
+    }
+    int packets = rand() % 8;
+    for (int p = 0;p<packets && pos+12<size;p++) {
+        data[pos++] = (rand() % 16) << 4 | (rand() % 16);
+        size_t length = rand() % (size-pos-10);
+        if (rand() % 4 == 0) {
+            length = rand();
+        }
+        // Remaining length, now and then with too many bytes
+        if (rand() % 16 == 0) {
+            for (int i = 0;i<5;i++) {
+                data[pos++] = 0x80 | rand();
+            }
+        }
+        do {
+            uint8_t digit = length % 128;
+            length /= 128;
+            if (length > 0) {
+                digit |= 0x80;
+            }
+            data[pos++] = digit;
+        } while (length > 0);
+        size_t body = rand() % (size-pos);
+        for (size_t i = 0;i<body && pos<size;i++) {
+            data[pos++] = rand();
+        }
+    }
+    return pos;
+}
+
+int main(int argc, char* argv[]) {
+    long count = (argc > 1) ? atol(argv[1]) : 10000;
+    srand((argc > 2) ? atoi(argv[2]) : 1);
+    uint8_t data[1024];
+    for (long i = 0;i<count;i++) {
+        size_t size = randomInput(data,64 + rand() % (sizeof(data)-64));
+        LLVMFuzzerTestOneInput(data,size);
+    }
+    std::cout << count << " random inputs" << std::endl;
+    return 0;
+}
+#endif
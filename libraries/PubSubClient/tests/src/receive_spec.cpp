@@ -3,6 +3,7 @@
 #include "Buffer.h"
 #include "BDDTest.h"
 #include "trace.h"
+#include <time.h>
 
 
 byte server[] = { 172, 16, 0, 2 };
@@ -26,6 +27,65 @@ void callback(char* topic, byte* payload, unsigned int length) {
     lastLength = length;
 }
 
+const char* viewTopic;
+size_t viewTopicLen;
+const uint8_t* viewPayload;
+size_t viewLength;
+uint16_t viewMsgId;
+uint8_t viewQos;
+boolean viewRetain;
+
+char chunkPayload[256];
+size_t chunkCount;
+size_t chunkTotal;
+bool chunkTopicOk;
+
+void chunk_callback(const char* topic, size_t topicLen, const uint8_t* chunk, size_t length, size_t offset, size_t total) {
+    callback_called = true;
+    chunkTopicOk = topicLen == 5 && memcmp(topic,"topic",5) == 0;
+    memcpy(chunkPayload+offset,chunk,length);
+    chunkCount++;
+    chunkTotal = total;
+}
+
+void view_callback(const char* topic, size_t topicLen, const uint8_t* payload, size_t length, uint16_t msgId, uint8_t qos, boolean retain) {
+    callback_called = true;
+    viewTopic = topic;
+    viewTopicLen = topicLen;
+    viewPayload = payload;
+    viewLength = length;
+    viewMsgId = msgId;
+    viewQos = qos;
+    viewRetain = retain;
+}
+
+int filterCalls[3];
+
+void filter_set(const char* topic, size_t topicLen, const uint8_t* payload, size_t length, uint16_t msgId, uint8_t qos, boolean retain) {
+    filterCalls[0]++;
+}
+
+void filter_all(const char* topic, size_t topicLen, const uint8_t* payload, size_t length, uint16_t msgId, uint8_t qos, boolean retain) {
+    filterCalls[1]++;
+}
+
+void filter_position(const char* topic, size_t topicLen, const uint8_t* payload, size_t length, uint16_t msgId, uint8_t qos, boolean retain) {
+    filterCalls[2]++;
+}
+
+// PUBLISH qos 0 of topic and payload, returns its length
+int publish_packet(byte* packet, const char* topic, const char* payload) {
+    int tl = strlen(topic);
+    int pl = strlen(payload);
+    packet[0] = 0x30;
+    packet[1] = 2+tl+pl;
+    packet[2] = 0;
+    packet[3] = tl;
+    memcpy(packet+4,topic,tl);
+    memcpy(packet+4+tl,payload,pl);
+    return 4+tl+pl;
+}
+
 int test_receive_callback() {
     IT("receives a callback message");
     reset_callback();
@@ -107,7 +167,7 @@ int test_receive_max_sized_message() {
 
     int length = MQTT_MAX_PACKET_SIZE;
     byte publish[] = {0x30,length-2,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
-    byte bigPublish[length];
+    byte bigPublish[length+1];
     memset(bigPublish,'A',length);
     bigPublish[length] = 'B';
     memcpy(bigPublish,publish,16);
@@ -143,7 +203,7 @@ int test_receive_oversized_message() {
 
     int length = MQTT_MAX_PACKET_SIZE+1;
     byte publish[] = {0x30,length-2,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
-    byte bigPublish[length];
+    byte bigPublish[length+1];
     memset(bigPublish,'A',length);
     bigPublish[length] = 'B';
     memcpy(bigPublish,publish,16);
@@ -154,6 +214,7 @@ int test_receive_oversized_message() {
     IS_TRUE(rc);
 
     IS_FALSE(callback_called);
+    IS_TRUE(client.rxDroppedCount() == 1);
 
     IS_FALSE(shimClient.error());
 
@@ -208,7 +269,7 @@ int test_receive_oversized_stream_message() {
     int length = MQTT_MAX_PACKET_SIZE+1;
     byte publish[] = {0x30,length-2,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
 
-    byte bigPublish[length];
+    byte bigPublish[length+1];
     memset(bigPublish,'A',length);
     bigPublish[length] = 'B';
     memcpy(bigPublish,publish,16);
@@ -222,7 +283,53 @@ int test_receive_oversized_stream_message() {
 
     IS_TRUE(callback_called);
     IS_TRUE(strcmp(lastTopic,"topic")==0);
-    IS_TRUE(lastLength == length-9);
+    // Only what is in the buffer, the stream got all of it
+    IS_TRUE(lastLength == MQTT_MAX_PACKET_SIZE-9);
+    IS_TRUE(memcmp(lastPayload,bigPublish+9,lastLength)==0);
+    IS_TRUE(stream.length() == length-9);
+
+    IS_FALSE(stream.error());
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_receive_stream_topic_oversized() {
+    IT("drops a streamed message with a topic longer than the buffer");
+    reset_callback();
+
+    Stream stream;
+
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient, stream);
+    IS_TRUE(client.setBufferSize(16,64));
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    // 20 bytes of topic, 4 bytes of payload
+    byte publish[28] = {0x30,0x1a,0x0,0x14};
+    memset(publish+4,'t',20);
+    memcpy(publish+24,"abcd",4);
+    shimClient.respond(publish,28);
+    stream.expect(publish+24,4);
+
+    byte pingresp[] = {0xd0,0x0};
+    shimClient.respond(pingresp,2);
+
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_FALSE(callback_called);
+    IS_TRUE(client.rxDroppedCount() == 1);
+
+    // The connection goes on with the next packet
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_TRUE(client.connected());
 
     IS_FALSE(stream.error());
     IS_FALSE(shimClient.error());
@@ -264,6 +371,374 @@ int test_receive_qos1() {
     END_IT
 }
 
+int test_receive_view() {
+    IT("receives a message as views into the buffer");
+    reset_callback();
+
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    client.setViewCallback(view_callback);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte publish[] = {0x31,0xe,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    shimClient.respond(publish,16);
+
+    rc = client.loop();
+
+    IS_TRUE(rc);
+
+    IS_TRUE(callback_called);
+    IS_TRUE(lastTopic[0] == 0);
+    IS_TRUE(viewTopicLen == 5);
+    IS_TRUE(memcmp(viewTopic,"topic",5)==0);
+    // topic is not moved nor terminated - the payload follows right after it
+    IS_TRUE((const uint8_t*)viewTopic+5 == viewPayload);
+    IS_TRUE(viewLength == 7);
+    IS_TRUE(memcmp(viewPayload,"payload",7)==0);
+    IS_TRUE(viewQos == 0);
+    IS_TRUE(viewRetain);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_receive_view_qos1() {
+    IT("receives a qos1 message as views and acknowledges it");
+    reset_callback();
+
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    client.setViewCallback(view_callback);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte publish[] = {0x32,0x10,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x12,0x34,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    shimClient.respond(publish,18);
+
+    byte puback[] = {0x40,0x2,0x12,0x34};
+    shimClient.expect(puback,4);
+
+    rc = client.loop();
+
+    IS_TRUE(rc);
+
+    IS_TRUE(callback_called);
+    IS_TRUE(viewTopicLen == 5);
+    IS_TRUE(memcmp(viewTopic,"topic",5)==0);
+    IS_TRUE(viewLength == 7);
+    IS_TRUE(memcmp(viewPayload,"payload",7)==0);
+    IS_TRUE(viewMsgId == 0x1234);
+    IS_TRUE(viewQos == 1);
+    IS_FALSE(viewRetain);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_receive_chunked_message() {
+    IT("passes an oversized message to the chunk callback");
+    reset_callback();
+    chunkCount = 0;
+
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    client.setChunkCallback(chunk_callback);
+    IS_TRUE(client.setBufferSize(32));
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    // qos1, 100 bytes payload - 21 bytes per chunk after the 11 bytes of header, topic and msgId
+    byte publish[111] = {0x32,0x6d,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x12,0x34};
+    for (int i = 0;i<100;i++) {
+        publish[11+i] = i;
+    }
+    shimClient.respond(publish,111);
+
+    byte puback[] = {0x40,0x2,0x12,0x34};
+    shimClient.expect(puback,4);
+
+    rc = client.loop();
+
+    IS_TRUE(rc);
+
+    IS_TRUE(callback_called);
+    IS_FALSE(lastTopic[0]);
+    IS_TRUE(chunkTopicOk);
+    IS_TRUE(chunkCount == 5);
+    IS_TRUE(chunkTotal == 100);
+    IS_TRUE(memcmp(chunkPayload,publish+11,100)==0);
+    IS_TRUE(client.rxDroppedCount() == 0);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_receive_chunked_property_length_invalid() {
+    IT("drops the connection on a chunked version 5 message with a property length past the packet");
+    reset_callback();
+    chunkCount = 0;
+
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x03, 0x00, 0x00, 0x00 };
+    shimClient.respond(connack,5);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    client.setChunkCallback(chunk_callback);
+    client.setProtocolVersion(MQTT_VERSION_5);
+    IS_TRUE(client.setBufferSize(32));
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    // Remaining length 0x40, 56 bytes left after the topic - property length 0x7f
+    byte publish[66] = {0x30,0x40,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x7f};
+    shimClient.respond(publish,66);
+
+    rc = client.loop();
+    IS_FALSE(rc);
+    IS_FALSE(callback_called);
+    IS_TRUE(chunkCount == 0);
+    IS_TRUE(client.state() == MQTT_DISCONNECTED);
+    IS_TRUE(client.rxDroppedCount() == 0);
+
+    END_IT
+}
+
+int test_receive_chunked_property_length_overlong() {
+    IT("drops the connection on a chunked version 5 message with a property length over 4 bytes");
+    reset_callback();
+    chunkCount = 0;
+
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x03, 0x00, 0x00, 0x00 };
+    shimClient.respond(connack,5);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    client.setChunkCallback(chunk_callback);
+    client.setProtocolVersion(MQTT_VERSION_5);
+    IS_TRUE(client.setBufferSize(32));
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    // Continuation bit set on every byte of the property length
+    byte publish[66] = {0x30,0x40,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x80,0x80,0x80,0x80,0x80,0x80,0x80};
+    shimClient.respond(publish,66);
+
+    rc = client.loop();
+    IS_FALSE(rc);
+    IS_FALSE(callback_called);
+    IS_TRUE(chunkCount == 0);
+    IS_TRUE(client.state() == MQTT_DISCONNECTED);
+
+    END_IT
+}
+
+int test_receive_caller_buffer() {
+    IT("receives a message into a caller supplied buffer");
+    reset_callback();
+
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    static uint8_t buf[32];
+    PubSubClient client(server, 1883, callback, shimClient);
+    client.setBuffer(buf,sizeof(buf));
+    IS_TRUE(client.getBufferSize() == 32);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte publish[] = {0x30,0xe,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    shimClient.respond(publish,16);
+    // 33 bytes
+    byte bigPublish[33] = {0x30,0x1f,0x0,0x5,0x74,0x6f,0x70,0x69,0x63};
+    memset(bigPublish+9,'A',24);
+    shimClient.respond(bigPublish,33);
+
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_TRUE(callback_called);
+    IS_TRUE(strcmp(lastTopic,"topic")==0);
+    IS_TRUE(lastLength == 7);
+
+    reset_callback();
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_FALSE(callback_called);
+    IS_TRUE(client.rxDroppedCount() == 1);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_receive_filters() {
+    IT("dispatches to the handlers of all matching filters");
+    reset_callback();
+    memset(filterCalls,0,sizeof(filterCalls));
+
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    IS_TRUE(client.addFilter("blinds/+/set",filter_set));
+    IS_TRUE(client.addFilter("blinds/#",filter_all));
+    IS_TRUE(client.addFilter("blinds/cover1/position",filter_position));
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte publish[64];
+    shimClient.respond(publish,publish_packet(publish,"blinds/cover1/set","open"));
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_TRUE(filterCalls[0] == 1);
+    IS_TRUE(filterCalls[1] == 1);
+    IS_TRUE(filterCalls[2] == 0);
+    IS_FALSE(callback_called);
+
+    // # also matches the parent level
+    shimClient.respond(publish,publish_packet(publish,"blinds","x"));
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_TRUE(filterCalls[0] == 1);
+    IS_TRUE(filterCalls[1] == 2);
+
+    shimClient.respond(publish,publish_packet(publish,"blinds/cover1/position","50"));
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_TRUE(filterCalls[1] == 3);
+    IS_TRUE(filterCalls[2] == 1);
+
+    // + is exactly one level
+    shimClient.respond(publish,publish_packet(publish,"blinds/a/b/set","open"));
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_TRUE(filterCalls[0] == 1);
+    IS_TRUE(filterCalls[1] == 4);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_receive_filters_fallback() {
+    IT("passes messages no filter matches to the callback");
+    reset_callback();
+    memset(filterCalls,0,sizeof(filterCalls));
+
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    IS_TRUE(client.addFilter("#",filter_all));
+    IS_TRUE(client.addFilter("+/set",filter_set));
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    // Wildcards in the first level don't match $ topics
+    byte publish[64];
+    shimClient.respond(publish,publish_packet(publish,"$SYS/set","1"));
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_TRUE(filterCalls[0] == 0);
+    IS_TRUE(filterCalls[1] == 0);
+    IS_TRUE(callback_called);
+    IS_TRUE(strcmp(lastTopic,"$SYS/set")==0);
+
+    reset_callback();
+    client.clearFilters();
+    shimClient.respond(publish,publish_packet(publish,"a/set","1"));
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_TRUE(filterCalls[1] == 0);
+    IS_TRUE(callback_called);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_add_filter_invalid() {
+    IT("refuses invalid filters and a full table");
+    ShimClient shimClient;
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    IS_FALSE(client.addFilter("a/b#",filter_all));
+    IS_FALSE(client.addFilter("a/#/b",filter_all));
+    IS_FALSE(client.addFilter("a+/b",filter_all));
+
+    char names[MQTT_MAX_FILTERS+1][4];
+    for (int i = 0;i<MQTT_MAX_FILTERS;i++) {
+        sprintf(names[i],"f%d",i);
+        IS_TRUE(client.addFilter(names[i],filter_all));
+    }
+    strcpy(names[MQTT_MAX_FILTERS],"new");
+    IS_FALSE(client.addFilter(names[MQTT_MAX_FILTERS],filter_all));
+    // Replacing a handler needs no room
+    IS_TRUE(client.addFilter("f0",filter_set));
+
+    END_IT
+}
+
+int test_receive_truncated_closed() {
+    IT("fails at once on a message cut off by a closed connection");
+    reset_callback();
+
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    // Remaining length 0xe, only the topic arrives
+    byte publish[] = {0x30,0xe,0x0,0x5,0x74,0x6f,0x70,0x69,0x63};
+    shimClient.respond(publish,9);
+    shimClient.setCloseWhenRead(true);
+
+    time_t start = time(0);
+    rc = client.loop();
+    IS_FALSE(rc);
+    IS_FALSE(callback_called);
+    // Not after the socket timeout
+    IS_TRUE(time(0)-start < MQTT_SOCKET_TIMEOUT);
+
+    END_IT
+}
+
 int main()
 {
     SUITE("Receive");
@@ -273,7 +748,18 @@ int main()
     test_drop_invalid_remaining_length_message();
     test_receive_oversized_message();
     test_receive_oversized_stream_message();
+    test_receive_stream_topic_oversized();
     test_receive_qos1();
+    test_receive_view();
+    test_receive_view_qos1();
+    test_receive_chunked_message();
+    test_receive_chunked_property_length_invalid();
+    test_receive_chunked_property_length_overlong();
+    test_receive_caller_buffer();
+    test_receive_filters();
+    test_receive_filters_fallback();
+    test_add_filter_invalid();
+    test_receive_truncated_closed();
 
     FINISH
 }
@@ -111,11 +111,11 @@ int test_subscribe_too_long() {
 
     // max length should be allowed
     //                            0        1         2         3         4         5         6         7         8         9         0         1         2
-    rc = client.subscribe((char*)"12345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789");
+    rc = client.subscribe((char*)"1234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678");
     IS_TRUE(rc);
 
     //                            0        1         2         3         4         5         6         7         8         9         0         1         2
-    rc = client.subscribe((char*)"123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890");
+    rc = client.subscribe((char*)"12345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789");
     IS_FALSE(rc);
 
     IS_FALSE(shimClient.error());
@@ -124,6 +124,142 @@ int test_subscribe_too_long() {
 }
 
 
+int test_subscribe_batch() {
+    IT("subscribes to several topics with one packet");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte subscribe[] = { 0x82,0x10,0x0,0x2,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x1,0x0,0x3,0x61,0x2f,0x62,0x0 };
+    shimClient.expect(subscribe,18);
+
+    const char* topics[] = { "topic", "a/b" };
+    uint8_t qos[] = { 1, 0 };
+    uint16_t writes = shimClient.writes();
+    rc = client.subscribe(topics,qos,2);
+    IS_TRUE(rc);
+    IS_TRUE(shimClient.writes() == writes+1);
+    IS_TRUE(client.subscribePending() == 1);
+
+    byte suback[] = { 0x90,0x4,0x0,0x2,0x1,0x0 };
+    shimClient.respond(suback,6);
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_TRUE(client.subscribePending() == 0);
+    IS_TRUE(client.subscribeRefused() == 0);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_subscribe_batch_split() {
+    IT("splits a subscribe batch that doesn't fit into the buffer");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    // 4 filters of 40 bytes (43 with length and qos) - two fit into 128 bytes, a third would end at 7+3*43 = 136
+    char topic[41];
+    memset(topic,'t',40);
+    topic[40] = 0;
+    const char* topics[] = { topic, topic, topic, topic };
+    uint16_t writes = shimClient.writes();
+    uint16_t received = shimClient.received();
+    rc = client.subscribe(topics,NULL,4);
+    IS_TRUE(rc);
+    IS_TRUE(shimClient.writes() == writes+2);
+    IS_TRUE(shimClient.received() == received+2*(4+2*43));
+    IS_TRUE(client.subscribePending() == 2);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_subscribe_refused() {
+    IT("counts filters refused in suback");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    const char* topics[] = { "topic", "a/b" };
+    rc = client.subscribe(topics,NULL,2);
+    IS_TRUE(rc);
+
+    byte suback[] = { 0x90,0x4,0x0,0x2,0x80,0x0 };
+    shimClient.respond(suback,6);
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_TRUE(client.subscribePending() == 0);
+    IS_TRUE(client.subscribeRefused() == 1);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_subscribe_refused_disconnect() {
+    IT("disconnects on a refused filter when asked to");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    client.setDisconnectOnRefused(true);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    const char* topics[] = { "topic", "a/b" };
+    rc = client.subscribe(topics,NULL,2);
+    IS_TRUE(rc);
+
+    byte suback[] = { 0x90,0x4,0x0,0x2,0x0,0x80 };
+    shimClient.respond(suback,6);
+    rc = client.loop();
+    IS_FALSE(rc);
+    IS_FALSE(client.connected());
+    IS_TRUE(client.state() == MQTT_SUBSCRIBE_REFUSED);
+    IS_TRUE(client.subscribeRefused() == 1);
+
+    // Subscribed again after the reconnect, all granted this time
+    shimClient.respond(connack,4);
+    rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+    rc = client.subscribe(topics,NULL,2);
+    IS_TRUE(rc);
+    byte granted[] = { 0x90,0x4,0x0,0x2,0x0,0x0 };
+    shimClient.respond(granted,6);
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_TRUE(client.state() == MQTT_CONNECTED);
+    IS_TRUE(client.subscribePending() == 0);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
 int test_unsubscribe() {
     IT("unsubscribes");
     ShimClient shimClient;
@@ -171,6 +307,10 @@ int main()
     test_subscribe_not_connected();
     test_subscribe_invalid_qos();
     test_subscribe_too_long();
+    test_subscribe_batch();
+    test_subscribe_batch_split();
+    test_subscribe_refused();
+    test_subscribe_refused_disconnect();
     test_unsubscribe();
     test_unsubscribe_not_connected();
     FINISH
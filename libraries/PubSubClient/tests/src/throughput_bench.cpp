@@ -0,0 +1,142 @@
+#include "PubSubClient.h"
+#include "ShimClient.h"
+#include <chrono>
+#include <iostream>
+#include <stdlib.h>
+
+// Publish and receive throughput through the ShimClient - no network, only the packet building,
+// parsing and copying - and the heap allocations per message
+
+byte server[] = { 172, 16, 0, 2 };
+
+unsigned long received;
+unsigned long allocations;
+
+// Every allocation of the process is counted (operator new ends up here too)
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t n, size_t size);
+extern "C" void* __libc_realloc(void* p, size_t size);
+
+extern "C" void* malloc(size_t size) {
+    allocations++;
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t n, size_t size) {
+    allocations++;
+    return __libc_calloc(n,size);
+}
+
+extern "C" void* realloc(void* p, size_t size) {
+    allocations++;
+    return __libc_realloc(p,size);
+}
+
+void callback(char* topic, byte* payload, unsigned int length) {
+    received += length;
+}
+
+void report(const char* what, int size, int count, double seconds, unsigned long allocated) {
+    std::cout << " - " << what << " " << size << " byte packets: "
+              << (unsigned long)(count/seconds) << " messages/s, "
+              << (unsigned long)((double)size*count/seconds) << " bytes/s, "
+              << (double)allocated/count << " allocations/message";
+}
+
+void bench_receive(int size, int count) {
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    client.setBufferSize(1024);
+    client.connect((char*)"client_bench");
+
+    // PUBLISH of size bytes in total, topic "bench"
+    byte publish[1024];
+    int lengthLength = (size-2 > 127) ? 2 : 1;
+    int remaining = size-1-lengthLength;
+    publish[0] = 0x30;
+    if (lengthLength == 1) {
+        publish[1] = remaining;
+    } else {
+        publish[1] = (remaining % 128) | 0x80;
+        publish[2] = remaining / 128;
+    }
+    int pos = 1+lengthLength;
+    publish[pos++] = 0;
+    publish[pos++] = 5;
+    memcpy(publish+pos,"bench",5);
+    pos += 5;
+    memset(publish+pos,'A',size-pos);
+
+    received = 0;
+    unsigned long allocated = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0;i<count;i++) {
+        shimClient.respond(publish,size);
+        client.loop();
+    }
+    auto end = std::chrono::steady_clock::now();
+    allocated = allocations-allocated;
+
+    report("receive",size,count,std::chrono::duration<double>(end-start).count(),allocated);
+    if (received != (unsigned long)(size-pos)*count) {
+        std::cout << " (payload mismatch)";
+    }
+    std::cout << std::endl;
+}
+
+void bench_publish(int size, int count, uint8_t qos) {
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    client.setBufferSize(1024);
+    client.connect((char*)"client_bench");
+
+    // Topic "bench", the rest of size is the payload
+    int payloadLength = size-((size-2 > 127) ? 3 : 2)-7-(qos > 0 ? 2 : 0);
+    byte payload[1024];
+    memset(payload,'A',payloadLength);
+    byte puback[] = { 0x40, 0x02, 0x00, 0x00 };
+
+    unsigned long allocated = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0;i<count;i++) {
+        client.publish("bench",payload,payloadLength,false,qos);
+        if (qos > 0) {
+            // Acknowledged right away, the slot is free for the next one
+            uint16_t msgId = ((i+1) % 0xFFFF)+1;
+            puback[2] = msgId >> 8;
+            puback[3] = msgId & 0xFF;
+            shimClient.respond(puback,4);
+            client.loop();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    allocated = allocations-allocated;
+
+    report(qos > 0 ? "publish qos1" : "publish",size,count,std::chrono::duration<double>(end-start).count(),allocated);
+    if (client.inflightCount() != 0) {
+        std::cout << " (not acknowledged)";
+    }
+    std::cout << std::endl;
+}
+
+int main()
+{
+    std::cout << "Throughput benchmark" << std::endl;
+    // 10 and 1000 bytes - compared with the byte by byte readPacket (README)
+    bench_receive(10,1000000);
+    bench_receive(1000,100000);
+    bench_publish(16,1000000,0);
+    bench_publish(1000,100000,0);
+    bench_publish(16,1000000,1);
+    return 0;
+}